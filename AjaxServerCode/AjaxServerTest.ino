@@ -6,16 +6,28 @@
 
 // ===Global Libraries===
 #include <WiFi.h>
-#include <WiFiClient.h>
-#include <WebServer.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
 #include <HardwareSerial.h>
 #include <string.h>
+#include <memory>
+#include <atomic>
 #include <EEPROM.h>
 
 // ===Web page header files===
-#include "index.h"
-#include "config.h"
-#include "credentials.h"
+// index.h, config.h and credentials.h are the page sources; the sketch only
+// includes the minified, gzipped copies HostTools/page_gzip.c makes of them.
+#include "pages_gz.h"
+
+// ===AVR128 link and telemetry snapshot definitions===
+#include "avr_link.h"
+#include "settings.h"
+#include "telemetry.h"
+#include "history.h"
+
+// ===Flash filesystem for the trip log===
+#include <LittleFS.h>
+#include "triplog.h"
 
 //===Global Variables=== 
 
@@ -23,8 +35,11 @@
 const int inputThresholdPin = 1; //Change when Aaron gets here
 
 // Set up ports and AJAX server
+// The async server answers requests from its own task while the acquisition
+// task owns SerialPort, so a slow client or UART never holds up anyone else.
 HardwareSerial SerialPort(1);
-WebServer server(80);
+AsyncWebServer server(80);
+AsyncEventSource events("/events");
 
 //  Defualt IP Code Setting
 //************************************************************
@@ -32,295 +47,1312 @@ IPAddress local_ip(192, 168, 0, 80); // The desired IP address for the access po
 IPAddress gateway(192, 168, 0, 80); // The IP address of the gateway (the access point itself)
 IPAddress subnet(255, 255, 255, 0); // The subnet mask for the network
 
-// Global Strings
-String webpage = "main";
-char buffer[16];
+// Page "/" serves. Set by loop() and the server task both, so no String
+enum WebPage : uint8_t { PAGE_MAIN, PAGE_CONFIG, PAGE_CREDENTIALS };
+std::atomic<WebPage> webpage(PAGE_MAIN);
+
+// Settings record, loaded from EEPROM in setup() (see settings.h)
+Settings settings;
+portMUX_TYPE settingsMux = portMUX_INITIALIZER_UNLOCKED; // Guards settings between loop() and the server task
+volatile bool settingsDirty = false;  // settings changed, loop() writes it back
 
 
 //===============================================================
 // This routine is executed when you open its IP in browser
 //===============================================================
-void handleRoot() {   // Webpage global variable choices which page to load 
- String s;
+// Pages are sent gzipped straight from flash. "/" serves a different page
+// depending on webpage, so the browser has to revalidate every time
+// (no-cache) and gets a 304 only if it already holds that same page.
+void handleRoot(AsyncWebServerRequest *request) {   // Webpage global variable choices which page to load 
+  const uint8_t *page = MAIN_page_gz;
+  size_t length = MAIN_page_gz_len;
+  const char *etag = MAIN_page_etag;
 
   //If condition to choice which page to load
-  if(webpage.equals("main")){
-    s = MAIN_page; //Read HTML contents
-  } else if(webpage.equals("config")){
-    s = CONFIG_page;
-  } else if(webpage.equals("credentials")){
-    s = CREDENTIAL_page;
+  WebPage current = webpage.load();
+  if(current == PAGE_MAIN){
+    page = MAIN_page_gz; //Read HTML contents
+    length = MAIN_page_gz_len;
+    etag = MAIN_page_etag;
+  } else if(current == PAGE_CONFIG){
+    page = CONFIG_page_gz;
+    length = CONFIG_page_gz_len;
+    etag = CONFIG_page_etag;
+  } else if(current == PAGE_CREDENTIALS){
+    page = CREDENTIAL_page_gz;
+    length = CREDENTIAL_page_gz_len;
+    etag = CREDENTIAL_page_etag;
   }
- 
-  server.send(200, "text/html", s); //Send web page
+
+  AsyncWebServerResponse *response;
+  if (request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == etag) {
+    response = request->beginResponse(304); // Browser already has this page
+  } else {
+    response = request->beginResponse_P(200, "text/html", page, length); //Send web page
+    response->addHeader("Content-Encoding", "gzip");
+  }
+  response->addHeader("ETag", etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
 }
 
 // ===Functions to handle HTML Page change requests===
+// The page reloads itself afterwards and handleRoot() serves the new one
 
-void handleConfigPage(){
-  webpage = "config"; // Change global webpage variable
-  handleRoot(); // Call handleRoot() function to change page
-  server.send(200, "text/plain", "Config Page"); // Send back message to the client side
+void handleConfigPage(AsyncWebServerRequest *request){
+  webpage = PAGE_CONFIG; // Change global webpage variable
+  request->send(200, "text/plain", "Config Page"); // Send back message to the client side
 }
 
-void handleRemotePage(){
-  webpage = "main";
-  handleRoot();
-  server.send(200, "text/plain", "Remote Page");
+void handleRemotePage(AsyncWebServerRequest *request){
+  webpage = PAGE_MAIN;
+  request->send(200, "text/plain", "Remote Page");
 }
 
-void handleWifiCredPage(){
-  webpage = "credentials";
-  handleRoot();
-  server.send(200, "text/plain", "Credentials Page");
+void handleWifiCredPage(AsyncWebServerRequest *request){
+  webpage = PAGE_CREDENTIALS;
+  request->send(200, "text/plain", "Credentials Page");
 }
  
-// ===Functions to request information and actions from the AVR128===
-void handlePackVoltage() {
-  memset(buffer,'\0',20); // Reset the global buffer variable
-  SerialPort.print("a\r\n"); // Send serial usart command to request information
-  SerialPort.readBytesUntil('\n', buffer, 16); // Wait for the information to return from the AVR128
-  String pack_voltage_array = String(buffer); // Store the buffer information to a variable
- 
- server.send(200, "text/plane", pack_voltage_array); // Send information to client ajax request
+// ===Background AVR128 poller===
+// Every telemetryRefreshMs the poller sends one snapshot request frame.
+// Reply bytes are fed to the frame parser as they arrive on later passes; a
+// reply that matches the request's sequence number refreshes the whole
+// snapshot at once. A lost or damaged reply just leaves the old values in
+// place until the next request.
+//
+// The poller runs in its own acquisition task, pinned to core 1 at a higher
+// priority than loop(), so nothing loop() blocks on (Wi-Fi reconnects, the
+// trip log drain) delays the UART. The Wi-Fi stack lives on core 0. The
+// acquisition task is the only one that touches SerialPort or the AVR128
+// protocol. Everyone else gets the snapshot through the seqlock in
+// telemetry.h with readSnapshot(), so a web request never waits on the UART
+// and the UART never waits on a web request.
+
+#define AVR_REPLY_TIMEOUT_MS 100   // Give up on a reply after this long
+#define ACQUISITION_CORE     1
+#define ACQUISITION_PRIORITY 2     // loop() runs at 1
+#define ACQUISITION_LATE_MS  5     // A pass this late counts as held up
+#define OLED_LINK_REFRESH_MS 5000  // The AVR128 renegotiates after every wake up
+
+TelemetrySnapshot snapshot;            // Acquisition task's working copy
+TelemetryShared sharedSnapshot;        // What everyone else reads
+
+AvrFrameParser avrParser;         // Frames coming back from the AVR128
+uint8_t avrSeq = 0;               // Sequence number of the last frame sent
+bool pollWaiting = false;         // True while a snapshot reply is outstanding
+uint8_t pollSeq = 0;              // Sequence number the reply has to carry
+unsigned long pollSentAt = 0;     // When the outstanding request was sent
+unsigned long pollTimeouts = 0;   // Requests that never got a good reply
+unsigned long telemetryRefreshMs = 500; // Ask for a new snapshot this often, set by /setPollRate
+volatile bool relayCycleQueued = false; // Set by loop(), sent by the acquisition task
+uint32_t oledBaud[AVR_OLED_COUNT];     // OLED link rates the AVR128 last reported, for /stats
+unsigned long oledLinkAskedAt = 0;
+
+// How the acquisition task keeps up, for /stats
+unsigned long acquisitionPasses = 0;
+unsigned long acquisitionLate = 0;    // Passes that started ACQUISITION_LATE_MS or more after the last
+unsigned long acquisitionMaxGap = 0;  // Longest time between passes, ms
+
+// Send one frame to the AVR128, returns the sequence number it went out with
+uint8_t sendAvrFrame(uint8_t type, const uint8_t *payload, uint8_t len) {
+  uint8_t frame[AVR_MAX_PAYLOAD + AVR_FRAME_OVERHEAD];
+
+  avrSeq++;
+  size_t n = avrBuildFrame(frame, type, avrSeq, payload, len);
+  SerialPort.write(frame, n);
+  return avrSeq;
 }
 
-//The following functtions are similiar to the first
+// Copy the whole snapshot out in one go so a reader never sees half an update
+void readSnapshot(TelemetrySnapshot &copy) {
+  telemetryRead(sharedSnapshot, copy);
+}
 
-void handlePackCurrent() {
-  memset(buffer,'\0',16);
-  SerialPort.print("b\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  String pack_current_array = String(buffer);
- 
- server.send(200, "text/plane", pack_current_array);
+void storeTelemetry(TelemetryField field, long value, unsigned long now) {
+  TelemetryValue &slot = snapshot.values[field];
+  if (!slot.valid || slot.value != value) {
+    snapshot.version++;
+  }
+  slot.value = value;
+  slot.updatedAt = now;
+  slot.valid = true;
 }
 
-void handlePackSOC() {
-  memset(buffer,'\0',16);
-  SerialPort.print("c\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  String pack_soc_array = String(buffer);
- 
- server.send(200, "text/plane", pack_soc_array);
+// Unpack a snapshot reply into the telemetry slots and publish them
+void storeSnapshot(const uint8_t *p, unsigned long now) {
+  storeTelemetry(TELEM_PACK_VOLTAGE, avrGetU16(p + SNAP_PACK_VOLTAGE), now);
+  storeTelemetry(TELEM_PACK_CURRENT, avrGetI16(p + SNAP_PACK_CURRENT), now);
+  storeTelemetry(TELEM_PACK_SOC, avrGetU16(p + SNAP_PACK_SOC), now);
+  storeTelemetry(TELEM_PACK_POWER, avrGetI32(p + SNAP_PACK_KWH), now);
+  storeTelemetry(TELEM_AUX5, avrGetU16(p + SNAP_AUX5), now);
+  storeTelemetry(TELEM_AUX12, avrGetU16(p + SNAP_AUX12), now);
+  storeTelemetry(TELEM_ACCY133, avrGetU16(p + SNAP_ACCY133), now);
+  for (int i = 0; i < 6; i++) { // Motor through Ambient, same order as the slots
+    storeTelemetry((TelemetryField)(TELEM_MOTOR + i), avrGetI16(p + SNAP_TEMPS + 2 * i), now);
+  }
+  if (!snapshot.flagsValid || snapshot.flags != p[SNAP_FLAGS]) {
+    snapshot.version++;
+  }
+  snapshot.flags = p[SNAP_FLAGS];
+  snapshot.flagsValid = true;
+  telemetryPublish(sharedSnapshot, snapshot);
 }
 
-void handlePackPower() {
-  memset(buffer,'\0', 16);
-  SerialPort.print("d\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  buffer[16] = '\0';
+void pollTelemetry() {
+  unsigned long now = millis();
 
-  String pack_power_array = String(buffer);
- 
- server.send(200, "text/plane", pack_power_array); 
+  while (SerialPort.available()) { // Feed whatever has arrived to the frame parser
+    if (!avrParseByte(avrParser, SerialPort.read())) {
+      continue;
+    }
+    if (pollWaiting && avrParser.seq == pollSeq &&
+        avrParser.type == (AVR_TYPE_SNAPSHOT | AVR_TYPE_REPLY) && avrParser.len == AVR_SNAPSHOT_LEN) {
+      storeSnapshot(avrParser.payload, now);
+      pollWaiting = false;
+    }
+    if (avrParser.type == (AVR_TYPE_OLED_LINK | AVR_TYPE_REPLY) && avrParser.len == AVR_OLED_LINK_LEN) {
+      for (int i = 0; i < AVR_OLED_COUNT; i++) {
+        oledBaud[i] = (uint32_t)avrGetI32(avrParser.payload + 4 * i);
+      }
+    }
+    // Anything else (relay cycle reply, NAK, a late reply) is ignored
+  }
+
+  if (pollWaiting && now - pollSentAt > AVR_REPLY_TIMEOUT_MS) { // No reply, keep the old values
+    pollTimeouts++;
+    pollWaiting = false;
+  }
+
+  if (!pollWaiting && now - pollSentAt >= telemetryRefreshMs) {
+    pollSeq = sendAvrFrame(AVR_TYPE_SNAPSHOT, NULL, 0);
+    pollSentAt = now;
+    pollWaiting = true;
+  }
 }
 
-void handleVoltageValue1() {
-  memset(buffer,'\0',16);
-  SerialPort.print("e\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  String voltageValue1 = String(buffer);
- 
- server.send(200, "text/plane", voltageValue1);
+void acquisitionTask(void *parameter) {
+  unsigned long lastPass = millis();
+
+  for (;;) {
+    unsigned long now = millis();
+    unsigned long gap = now - lastPass;
+    lastPass = now;
+    acquisitionPasses++;
+    if (gap >= ACQUISITION_LATE_MS) {
+      acquisitionLate++;
+    }
+    if (gap > acquisitionMaxGap) {
+      acquisitionMaxGap = gap;
+    }
+
+    pollTelemetry();
+    if (relayCycleQueued) {
+      relayCycleQueued = false;
+      sendAvrFrame(AVR_TYPE_RELAY_CYCLE, NULL, 0); // AVR128 power cycles the relay and the ESP32
+    }
+    if (millis() - oledLinkAskedAt >= OLED_LINK_REFRESH_MS) {
+      sendAvrFrame(AVR_TYPE_OLED_LINK, NULL, 0); // Reply is picked up by pollTelemetry()
+      oledLinkAskedAt = millis();
+    }
+    vTaskDelay(1); // The UART driver buffers what arrives meanwhile
+  }
 }
 
-void handleVoltageValue2() {
-  memset(buffer,'\0',16);
-  SerialPort.print("f\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  String voltageValue2 = String(buffer);
- 
- server.send(200, "text/plane", voltageValue2);
+// /stats reports how the acquisition task and the snapshot readers get along
+void handleStats(AsyncWebServerRequest *request) {
+  char json[384];
+
+  snprintf(json, sizeof(json),
+           "{\"acquisition\":{\"core\":%d,\"passes\":%lu,\"late\":%lu,\"maxGap\":%lu,"
+           "\"frames\":%lu,\"crcErrors\":%lu,\"timeouts\":%lu,\"publishes\":%lu},"
+           "\"readers\":{\"reads\":%lu,\"retries\":%lu,\"waits\":%lu},\"webCore\":%d,"
+           "\"oledBaud\":[%lu,%lu,%lu]}",
+           ACQUISITION_CORE, acquisitionPasses, acquisitionLate, acquisitionMaxGap,
+           (unsigned long)avrParser.frames, (unsigned long)avrParser.crcErrors, pollTimeouts,
+           (unsigned long)sharedSnapshot.publishes.load(), (unsigned long)sharedSnapshot.reads.load(),
+           (unsigned long)sharedSnapshot.retries.load(), (unsigned long)sharedSnapshot.waits.load(),
+           (int)xPortGetCoreID(), (unsigned long)oledBaud[0], (unsigned long)oledBaud[1],
+           (unsigned long)oledBaud[2]);
+  request->send(200, "application/json", json);
 }
 
-void handleVoltageValue3() {
-  memset(buffer,'\0',16);
-  SerialPort.print("g\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  String voltageValue3 = String(buffer);
- 
- server.send(200, "text/plane", voltageValue3);
+void handleSetPollRate(AsyncWebServerRequest *request) {
+  long ms = request->arg("ms").toInt();
+  if (ms < 100 || ms > 10000) {
+    request->send(400, "text/plain", "ms must be 100..10000");
+    return;
+  }
+  telemetryRefreshMs = ms;
+  portENTER_CRITICAL(&settingsMux);
+  settings.telemetryRefreshMs = ms;
+  portEXIT_CRITICAL(&settingsMux);
+  settingsDirty = true;
+  request->send(200, "text/plain", String(telemetryRefreshMs));
 }
 
-void handleMotorValue() {
-  memset(buffer,'\0',16);
-  SerialPort.print("h\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  float floatMotorValue = atof(buffer);
-  floatMotorValue = floatMotorValue / 10;
-  String motorValue = String(floatMotorValue);
- 
- server.send(200, "text/plane", motorValue);
+// Write a fixed point number with its decimal point, e.g. (-43211, 1) -> "-4321.1"
+size_t formatFixed(char *out, size_t size, long value, uint8_t decimals) {
+  long scale = 1;
+  for (uint8_t i = 0; i < decimals; i++) {
+    scale *= 10;
+  }
+
+  const char *sign = "";
+  if (value < 0) {
+    sign = "-";
+    value = -value;
+  }
+  if (decimals == 0) {
+    return snprintf(out, size, "%s%ld", sign, value);
+  }
+  return snprintf(out, size, "%s%ld.%0*ld", sign, value / scale, decimals, value % scale);
 }
 
-void handleControllerValue() {
-  memset(buffer,'\0',16);
-  SerialPort.print("i\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  float floatControllerValue = atof(buffer);
-  floatControllerValue = floatControllerValue / 10;
-  String controllerValue = String(floatControllerValue);
- 
- server.send(200, "text/plane", controllerValue);
+// Turn a slot back into text, e.g. 17654 -> "176.54V"
+void formatTelemetry(const TelemetrySnapshot &snap, TelemetryField field, char *out, size_t size) {
+  if (!snap.values[field].valid) {
+    out[0] = '\0';
+    return;
+  }
+
+  const TelemetryFormat &format = TELEMETRY_FORMATS[field];
+  long value = snap.values[field].value;
+  size_t n = 0;
+  if (format.showPlus && value >= 0) {
+    out[n++] = '+';
+  }
+  n += formatFixed(out + n, size - n, value, format.decimals);
+  snprintf(out + n, size - n, "%s", format.unit);
 }
 
-void handleDCDCValue() {
-  memset(buffer,'\0',16);
-  SerialPort.print("j\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  float floatDCDCValue = atof(buffer);
-  floatDCDCValue = floatDCDCValue / 10;
-  String dcdcValue = String(floatDCDCValue);
- 
- server.send(200, "text/plane", dcdcValue);
+// Send one value from the snapshot, with its age in the X-Telemetry-Age header
+void sendTelemetry(AsyncWebServerRequest *request, TelemetryField field) {
+  TelemetrySnapshot snap;
+  char text[20];
+  long age = -1; // -1 means no reply has arrived yet
+
+  readSnapshot(snap);
+  if (snap.values[field].valid) {
+    age = millis() - snap.values[field].updatedAt;
+  }
+  formatTelemetry(snap, field, text, sizeof(text));
+
+  AsyncWebServerResponse *response = request->beginResponse(200, "text/plane", text);
+  response->addHeader("X-Telemetry-Age", String(age));
+  request->send(response);
 }
 
-void handleBBoxValue1() {
-  memset(buffer,'\0',16);
-  SerialPort.print("k\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  float floatBBoxValue1 = atof(buffer);
-  floatBBoxValue1 = floatBBoxValue1 / 10;
-  String bboxValue1 = String(floatBBoxValue1);
- 
- server.send(200, "text/plane", bboxValue1);
+// ===Functions to answer information requests from the telemetry snapshot===
+void handlePackVoltage(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_PACK_VOLTAGE); // Send cached value to client ajax request
 }
 
-void handleBBoxValue2() {
-  memset(buffer,'\0',16);
-  SerialPort.print("l\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  float floatBBoxValue2 = atof(buffer);
-  floatBBoxValue2 = floatBBoxValue2 / 10;
-  String bboxValue2 = String(floatBBoxValue2);
- 
- server.send(200, "text/plane", bboxValue2);
+//The following functtions are similiar to the first
+
+void handlePackCurrent(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_PACK_CURRENT);
 }
 
-void handleAmbientValue() {
-  memset(buffer,'\0',16);
-  SerialPort.print("m\r\n");
-  SerialPort.readBytesUntil('\n', buffer, 16);
-  float floatAmbientValue = atof(buffer);
-  floatAmbientValue = floatAmbientValue / 10;
-  String ambientValue = String(floatAmbientValue);
- 
- server.send(200, "text/plane", ambientValue);
+void handlePackSOC(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_PACK_SOC);
+}
+
+void handlePackPower(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_PACK_POWER);
+}
+
+void handleVoltageValue1(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_AUX5);
+}
+
+void handleVoltageValue2(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_AUX12);
+}
+
+void handleVoltageValue3(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_ACCY133);
+}
+
+void handleMotorValue(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_MOTOR);
+}
+
+void handleControllerValue(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_CONTROLLER);
+}
+
+void handleDCDCValue(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_DCDC);
+}
+
+void handleBBoxValue1(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_BBOX1);
+}
+
+void handleBBoxValue2(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_BBOX2);
+}
+
+void handleAmbientValue(AsyncWebServerRequest *request) {
+  sendTelemetry(request, TELEM_AMBIENT);
 }
 
 
-void handleThreshold() {
+void handleThreshold(AsyncWebServerRequest *request) {
 
   bool state = digitalRead(inputThresholdPin); // Read state of input threshold signifying pin
 
   if (!state){
-    server.send(200, "text/plane", "LOW");
+    request->send(200, "text/plane", "LOW");
   }else{
-    server.send(200, "text/plane", "HIGH");
+    request->send(200, "text/plane", "HIGH");
   }
  
 }
 
+// ===Batched request: every telemetry value in one compact JSON response===
+// {"v":"176.54V","i":"+12.3A","soc":"98.7%","kwh":"-4321.1WH",
+//  "aux":["5.12","12.40","13.31"],"t":[motor,controller,dcdc,bbox1,bbox2,ambient],
+//  "fl":AVR128 state flags (AVR_FLAG_* bits, null = no data),
+//  "th":"LOW","age":[ms per snapshot slot, -1 = no data]}
+// Temperatures stay in tenths of a degree and the page does the division.
+
+#define ALL_JSON_SIZE 512
+
+// Append a slot as a JSON string, or null if the value never arrived
+size_t appendJsonValue(const TelemetrySnapshot &snap, char *out, size_t size, size_t pos, TelemetryField field) {
+  if (!snap.values[field].valid) {
+    return pos + snprintf(out + pos, size - pos, "null");
+  }
+
+  char text[20];
+  formatTelemetry(snap, field, text, sizeof(text));
+  return pos + snprintf(out + pos, size - pos, "\"%s\"", text);
+}
+
+// Append a temperature as a plain number of tenths, or null
+size_t appendJsonTenths(const TelemetrySnapshot &snap, char *out, size_t size, size_t pos, TelemetryField field) {
+  if (!snap.values[field].valid) {
+    return pos + snprintf(out + pos, size - pos, "null");
+  }
+  return pos + snprintf(out + pos, size - pos, "%ld", snap.values[field].value);
+}
+
+// Write the whole snapshot as JSON into out (ALL_JSON_SIZE bytes), returns its length
+size_t buildAllJson(const TelemetrySnapshot &snap, char *out, size_t size) {
+  size_t pos = 0;
+  unsigned long now = millis();
+
+  pos += snprintf(out + pos, size - pos, "{\"v\":");
+  pos = appendJsonValue(snap, out, size, pos, TELEM_PACK_VOLTAGE);
+  pos += snprintf(out + pos, size - pos, ",\"i\":");
+  pos = appendJsonValue(snap, out, size, pos, TELEM_PACK_CURRENT);
+  pos += snprintf(out + pos, size - pos, ",\"soc\":");
+  pos = appendJsonValue(snap, out, size, pos, TELEM_PACK_SOC);
+  pos += snprintf(out + pos, size - pos, ",\"kwh\":");
+  pos = appendJsonValue(snap, out, size, pos, TELEM_PACK_POWER);
+
+  pos += snprintf(out + pos, size - pos, ",\"aux\":[");
+  for (int f = TELEM_AUX5; f <= TELEM_ACCY133; f++) {
+    if (f != TELEM_AUX5) {
+      out[pos++] = ',';
+    }
+    pos = appendJsonValue(snap, out, size, pos, (TelemetryField)f);
+  }
+
+  pos += snprintf(out + pos, size - pos, "],\"t\":[");
+  for (int f = TELEM_MOTOR; f <= TELEM_AMBIENT; f++) {
+    if (f != TELEM_MOTOR) {
+      out[pos++] = ',';
+    }
+    pos = appendJsonTenths(snap, out, size, pos, (TelemetryField)f);
+  }
+
+  if (snap.flagsValid) {
+    pos += snprintf(out + pos, size - pos, "],\"fl\":%u", snap.flags);
+  } else {
+    pos += snprintf(out + pos, size - pos, "],\"fl\":null");
+  }
+
+  bool state = digitalRead(inputThresholdPin); // Same threshold signal as /readThreshold
+  pos += snprintf(out + pos, size - pos, ",\"th\":\"%s\",\"age\":[", state ? "HIGH" : "LOW");
+  for (int f = 0; f < TELEM_COUNT; f++) {
+    long age = -1;
+    if (snap.values[f].valid) {
+      age = now - snap.values[f].updatedAt;
+    }
+    pos += snprintf(out + pos, size - pos, f == 0 ? "%ld" : ",%ld", age);
+  }
+  pos += snprintf(out + pos, size - pos, "]}");
+  return pos;
+}
+
+void handleReadAll(AsyncWebServerRequest *request) {
+  TelemetrySnapshot snap;
+  char json[ALL_JSON_SIZE];
+
+  readSnapshot(snap);
+  buildAllJson(snap, json, sizeof(json));
+  request->send(200, "application/json", json);
+}
+
+// ===Server-Sent Events push channel===
+// Pages open an EventSource on /events and the ESP32 pushes to them instead of
+// being polled. A "telemetry" event (same JSON as /readAll) goes out when the
+// snapshot or threshold pin changes, at most once per pushIntervalMs. A
+// "network" event goes out when the IP settings change. The async server
+// keeps the subscriber connections, pushEvents() in loop() decides what to send.
+// It keeps track of the state while nobody is listening too, so a new
+// subscriber doesn't get what onEventsConnect() just sent it a second time.
+
+#define NETWORK_CHECK_MS 1000          // How often to look for IP setting changes
+
+unsigned long pushIntervalMs = 500;    // Fastest telemetry push rate, set by /setPushRate
+unsigned long lastTelemetryPush = 0;
+unsigned long pushedTelemetryVersion = 0;
+bool pushedThreshold = false;
+unsigned long lastNetworkCheck = 0;
+char networkJson[128];                 // Last network event sent
+
+size_t buildNetworkJson(char *out, size_t size) {
+  return snprintf(out, size, "{\"ip\":\"%s\",\"dns\":\"%s\",\"mask\":\"%s\",\"mac\":\"%s\"}",
+                  WiFi.localIP().toString().c_str(), WiFi.dnsIP().toString().c_str(),
+                  WiFi.subnetMask().toString().c_str(), WiFi.macAddress().c_str());
+}
+
+// New subscribers get the current state straight away
+void onEventsConnect(AsyncEventSourceClient *client) {
+  TelemetrySnapshot snap;
+  char json[ALL_JSON_SIZE];
+  char network[sizeof(networkJson)];
+
+  readSnapshot(snap);
+  buildAllJson(snap, json, sizeof(json));
+  client->send(json, "telemetry", millis(), 2000);
+  buildNetworkJson(network, sizeof(network));
+  client->send(network, "network", millis());
+}
+
+void handleSetPushRate(AsyncWebServerRequest *request) {
+  long ms = request->arg("ms").toInt();
+  if (ms < 100 || ms > 10000) {
+    request->send(400, "text/plain", "ms must be 100..10000");
+    return;
+  }
+  pushIntervalMs = ms;
+  portENTER_CRITICAL(&settingsMux);
+  settings.pushIntervalMs = ms;
+  portEXIT_CRITICAL(&settingsMux);
+  settingsDirty = true;
+  request->send(200, "text/plain", String(pushIntervalMs));
+}
+
+// Called from loop(), pushes whatever changed to the subscribers
+void pushEvents() {
+  unsigned long now = millis();
+  bool listening = events.count() != 0; // If not, keep track but build nothing
+
+  bool threshold = digitalRead(inputThresholdPin);
+  TelemetrySnapshot snap;
+  readSnapshot(snap);
+  if (!listening) {
+    pushedTelemetryVersion = snap.version;
+    pushedThreshold = threshold;
+  } else if ((snap.version != pushedTelemetryVersion || threshold != pushedThreshold) &&
+             now - lastTelemetryPush >= pushIntervalMs) {
+    char json[ALL_JSON_SIZE];
+
+    pushedTelemetryVersion = snap.version;
+    pushedThreshold = threshold;
+    lastTelemetryPush = now;
+    buildAllJson(snap, json, sizeof(json));
+    events.send(json, "telemetry", now);
+  }
+
+  if (now - lastNetworkCheck >= NETWORK_CHECK_MS) {
+    char current[sizeof(networkJson)];
+    lastNetworkCheck = now;
+    buildNetworkJson(current, sizeof(current));
+    if (strcmp(current, networkJson) != 0) {
+      strcpy(networkJson, current);
+      if (listening) {
+        events.send(networkJson, "network", now);
+      }
+    }
+  }
+}
+
+// ===Flash trip log===
+// historySample() feeds every sample into a small ring of its own as well.
+// Each block it finishes is queued for the logger task, which does all of the
+// flash work (see triplog.h), so neither loop() nor the web handlers ever wait
+// on a flash write. If the task falls behind the queue fills and blocks are
+// dropped and counted instead.
+
+TripLog tripLog;
+HistoryBlock tripBlocks[2];
+HistoryRing tripRing = {{tripBlocks}, 2, 0, 1};
+QueueHandle_t tripLogQueue = NULL;       // NULL when the partition did not mount
+volatile unsigned long tripLogSent = 0;  // Messages queued by loop()
+volatile unsigned long tripLogDone = 0;  // Messages finished by the logger task
+unsigned long tripLogDropped = 0;        // Blocks lost to a full queue
+unsigned long lastTripLogFlush = 0;
+uint8_t tripLogActive = 0;               // EVIM and charge flags of the last sample
+
+void tripLogTask(void *parameter) {
+  TripLogMessage message;
+  for (;;) {
+    if (xQueueReceive(tripLogQueue, &message, portMAX_DELAY) == pdTRUE) {
+      tripLogHandle(tripLog, message);
+      tripLogDone++;
+    }
+  }
+}
+
+void tripLogSend(uint8_t command, const HistoryBlock *block) {
+  TripLogMessage message;
+
+  message.command = command;
+  if (block != NULL) {
+    message.block = *block;
+  } else {
+    message.block.records = 0;
+  }
+  if (xQueueSend(tripLogQueue, &message, 0) == pdTRUE) {
+    tripLogSent++;
+  } else {
+    tripLogDropped++;
+  }
+}
+
+// Hand over the block being filled without waiting for it to fill up
+void tripLogFlush(uint8_t command) {
+  HistoryBlock *block = &historyBlock(tripRing, tripRing.head);
+  tripLogSend(command, block->seq != 0 ? block : NULL);
+  historyCloseBlock(tripRing);
+  lastTripLogFlush = millis();
+}
+
+// Called by historySample() with every sample
+void tripLogSample(const long *values, uint16_t valid, uint32_t now) {
+  uint8_t active = 0;
+
+  if (tripLogQueue == NULL) {
+    return;
+  }
+  if (valid & (1 << HISTORY_FLAGS)) {
+    active = values[HISTORY_FLAGS] & (AVR_FLAG_EVIM_STATE | AVR_FLAG_CHARGE_CYCLE);
+  }
+  if (active != 0 && active != tripLogActive) { // Drive or charge starting
+    tripLogFlush(TRIPLOG_NEW_TRIP);
+  } else if (active == 0 && tripLogActive != 0) { // and ending, get it onto flash
+    tripLogFlush(TRIPLOG_SYNC);
+  }
+  tripLogActive = active;
+
+  if (historyAppend(tripRing, values, valid, now)) {
+    tripLogSend(TRIPLOG_BLOCK, &historyBlock(tripRing, (tripRing.head + tripRing.count - 1) % tripRing.count));
+  }
+  if (now - lastTripLogFlush >= TRIPLOG_FLUSH_MS) {
+    tripLogFlush(TRIPLOG_SYNC);
+  }
+}
+
+// Get everything onto flash before the power goes, gives up after timeout ms
+void tripLogDrain(unsigned long timeout) {
+  unsigned long start = millis();
+
+  if (tripLogQueue == NULL) {
+    return;
+  }
+  tripLogFlush(TRIPLOG_SYNC);
+  while (tripLogDone != tripLogSent && millis() - start < timeout) {
+    delay(10);
+  }
+}
+
+// /trips lists the trip files, oldest first is not guaranteed
+void handleTrips(AsyncWebServerRequest *request) {
+  if (tripLogQueue == NULL) {
+    request->send(503, "text/plain", "Trip log not mounted");
+    return;
+  }
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  File dir = LittleFS.open(TRIPLOG_DIR);
+  bool first = true;
+
+  response->printf("{\"current\":%lu,\"used\":%lu,\"total\":%lu,\"cap\":%lu,\"blocks\":%lu,"
+                   "\"dropped\":%lu,\"errors\":%lu,\"deleted\":%lu,\"trips\":[",
+                   (unsigned long)tripLog.trip, (unsigned long)LittleFS.usedBytes(),
+                   (unsigned long)LittleFS.totalBytes(), (unsigned long)tripLog.capBytes,
+                   (unsigned long)tripLog.blocksWritten, tripLogDropped,
+                   (unsigned long)tripLog.writeErrors, (unsigned long)tripLog.filesDeleted);
+  if (dir && dir.isDirectory()) {
+    for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+      uint32_t trip = tripLogNumber(f.name());
+      if (trip == 0) {
+        continue;
+      }
+      response->printf("%s{\"n\":%lu,\"size\":%lu}", first ? "" : ",",
+                       (unsigned long)trip, (unsigned long)f.size());
+      first = false;
+    }
+  }
+  response->printf("]}");
+  request->send(response);
+}
+
+// /trip?n=12 streams one trip file, same layout as /history?format=bin
+void handleTrip(AsyncWebServerRequest *request) {
+  uint32_t trip = request->arg("n").toInt();
+  char path[32];
+  char disposition[48];
+
+  if (tripLogQueue == NULL) {
+    request->send(503, "text/plain", "Trip log not mounted");
+    return;
+  }
+  tripLogPath(path, sizeof(path), trip);
+  File file = LittleFS.open(path, "r");
+  if (trip == 0 || !file) {
+    request->send(404, "text/plain", "No such trip");
+    return;
+  }
+
+  // Read a chunk at a time, the trip being written can be fetched too and
+  // ends at its last sync
+  AsyncWebServerResponse *response = request->beginChunkedResponse(
+    "application/octet-stream",
+    [file](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+      return file.read(buffer, maxLen); // 0 at the end of the file ends the response
+    });
+  snprintf(disposition, sizeof(disposition), "attachment; filename=\"trip%05lu.wmh\"",
+           (unsigned long)trip);
+  response->addHeader("Content-Disposition", disposition);
+  request->send(response);
+}
+
+// ===Telemetry history===
+// loop() samples the snapshot into the ring every historyIntervalMs (see
+// history.h). /history streams it back block by block: each callback from the
+// server copies one block out under the lock and decodes it, so a download
+// never needs more than one block of heap however long the range is.
+
+HistoryRing history;
+portMUX_TYPE historyMux = portMUX_INITIALIZER_UNLOCKED; // Guards history between loop() and the server task
+unsigned long historyIntervalMs = 1000;  // Sample period, set by /setHistoryRate
+unsigned long lastHistorySample = 0;
+
+const char HISTORY_CSV_HEADER[] =
+  "t_ms,pack_v,pack_a,soc,wh,aux5,aux12,accy133,motor,controller,dcdc,bbox1,bbox2,ambient,flags\n";
+
+// Called from loop()
+void historySample() {
+  unsigned long now = millis();
+  long values[HISTORY_CHANNELS];
+  uint16_t valid = 0;
+  TelemetrySnapshot snap;
+
+  if (now - lastHistorySample < historyIntervalMs) {
+    return;
+  }
+  lastHistorySample = now;
+
+  readSnapshot(snap);
+  for (int f = 0; f < TELEM_COUNT; f++) {
+    values[f] = snap.values[f].value;
+    if (snap.values[f].valid) {
+      valid |= 1 << f;
+    }
+  }
+  values[HISTORY_FLAGS] = snap.flags;
+  if (snap.flagsValid) {
+    valid |= 1 << HISTORY_FLAGS;
+  }
+  if (valid == 0) {
+    return; // Nothing heard from the AVR128 yet
+  }
+
+  portENTER_CRITICAL(&historyMux);
+  historyAppend(history, values, valid, now);
+  portEXIT_CRITICAL(&historyMux);
+
+  tripLogSample(values, valid, now);
+}
+
+// State of one /history download, lives as long as the response does
+struct HistoryStream {
+  HistoryDecoder decoder;
+  bool loaded;           // decoder holds a block
+  uint32_t seq;          // Next block to load
+  uint32_t from, to;     // Wanted range, ms since boot
+  bool csv;
+  bool started;          // Header sent
+  bool finished;
+  uint8_t pending[HISTORY_PACKED_MAX]; // Bytes waiting to go out
+  uint16_t pendingLength;
+  uint16_t pendingPos;
+};
+
+// Copy the next block of the range into the decoder, false when there are no more
+bool historyLoadBlock(HistoryStream &s) {
+  for (;;) {
+    bool ok = false;
+    bool skip = false;
+
+    portENTER_CRITICAL(&historyMux);
+    uint32_t oldest = historyOldestSeq(history);
+    if (s.seq < oldest) { // Overwritten while we were sending, carry on from the oldest
+      s.seq = oldest;
+    }
+    int slot = historyFindBlock(history, s.seq);
+    if (slot >= 0) {
+      int next = historyFindBlock(history, s.seq + 1);
+      skip = next >= 0 && historyBlock(history, next).startTime <= s.from; // Ends before the range
+      if (!skip) {
+        s.decoder.block = historyBlock(history, slot);
+      }
+      ok = true;
+    }
+    portEXIT_CRITICAL(&historyMux);
+
+    if (!ok) {
+      return false;
+    }
+    s.seq++;
+    if (skip) {
+      continue;
+    }
+    if (s.decoder.block.startTime > s.to) {
+      return false;
+    }
+    historyDecodeStart(s.decoder);
+    return true;
+  }
+}
+
+// Refill pending with the next CSV line or binary block, false when done
+bool historyNextPending(HistoryStream &s) {
+  s.pendingPos = 0;
+  s.pendingLength = 0;
+
+  if (!s.started) {
+    s.started = true;
+    if (s.csv) {
+      s.pendingLength = strlen(HISTORY_CSV_HEADER);
+      memcpy(s.pending, HISTORY_CSV_HEADER, s.pendingLength);
+    } else {
+      s.pendingLength = historyPackHeader(s.pending);
+    }
+    return true;
+  }
+
+  if (!s.csv) { // Whole blocks
+    if (!historyLoadBlock(s)) {
+      return false;
+    }
+    s.pendingLength = historyPackBlock(s.pending, s.decoder.block);
+    return true;
+  }
+
+  for (;;) {
+    if (!s.loaded || !historyDecodeNext(s.decoder)) {
+      s.loaded = historyLoadBlock(s);
+      if (!s.loaded) {
+        return false;
+      }
+      continue;
+    }
+    if (s.decoder.time < s.from) {
+      continue;
+    }
+    if (s.decoder.time > s.to) {
+      return false;
+    }
+
+    char *line = (char *)s.pending;
+    size_t size = sizeof(s.pending);
+    size_t n = snprintf(line, size, "%lu", (unsigned long)s.decoder.time);
+    for (int c = 0; c < HISTORY_CHANNELS; c++) {
+      line[n++] = ',';
+      if (!(s.decoder.valid & (1 << c))) {
+        continue; // Empty field, not heard yet
+      }
+      if (c == HISTORY_FLAGS) {
+        n += snprintf(line + n, size - n, "%ld", s.decoder.values[c]);
+      } else {
+        n += formatFixed(line + n, size - n, s.decoder.values[c], TELEMETRY_FORMATS[c].decimals);
+      }
+    }
+    line[n++] = '\n';
+    s.pendingLength = n;
+    return true;
+  }
+}
+
+// /history?format=csv|bin&from=ms&to=ms  or  ?last=seconds  (times are ms since boot)
+void handleHistory(AsyncWebServerRequest *request) {
+  std::shared_ptr<HistoryStream> stream = std::make_shared<HistoryStream>();
+  unsigned long now = millis();
+
+  stream->csv = !(request->hasArg("format") && request->arg("format") == "bin");
+  stream->from = 0;
+  stream->to = now;
+  if (request->hasArg("from")) {
+    stream->from = request->arg("from").toInt();
+  }
+  if (request->hasArg("to")) {
+    stream->to = request->arg("to").toInt();
+  }
+  if (request->hasArg("last")) {
+    unsigned long last = request->arg("last").toInt() * 1000UL;
+    stream->from = (last < now) ? now - last : 0;
+  }
+  portENTER_CRITICAL(&historyMux);
+  stream->seq = historyOldestSeq(history);
+  portEXIT_CRITICAL(&historyMux);
+
+  AsyncWebServerResponse *response = request->beginChunkedResponse(
+    stream->csv ? "text/csv" : "application/octet-stream",
+    [stream](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      HistoryStream &s = *stream;
+      size_t n = 0;
+      while (n < maxLen && !s.finished) {
+        if (s.pendingPos >= s.pendingLength) {
+          if (!historyNextPending(s)) {
+            s.finished = true;
+            break;
+          }
+          continue;
+        }
+        size_t take = min((size_t)(s.pendingLength - s.pendingPos), maxLen - n);
+        memcpy(buffer + n, s.pending + s.pendingPos, take);
+        s.pendingPos += take;
+        n += take;
+      }
+      return n; // 0 ends the response
+    });
+  if (!stream->csv) {
+    response->addHeader("Content-Disposition", "attachment; filename=\"history.bin\"");
+  }
+  request->send(response);
+}
+
+void handleHistoryInfo(AsyncWebServerRequest *request) {
+  char json[256];
+  uint32_t oldestTime = 0, newestTime = 0;
+  unsigned long samples = 0, bytes = 0;
+
+  portENTER_CRITICAL(&historyMux);
+  uint32_t oldest = historyOldestSeq(history);
+  uint32_t newest = history.count ? historyBlock(history, history.head).seq : 0;
+  for (uint32_t seq = oldest; seq != 0 && seq <= newest; seq++) {
+    int slot = historyFindBlock(history, seq);
+    if (slot < 0) {
+      continue;
+    }
+    if (seq == oldest) {
+      oldestTime = historyBlock(history, slot).startTime;
+    }
+    samples += historyBlock(history, slot).records;
+    bytes += historyBlock(history, slot).used;
+  }
+  newestTime = history.lastTime;
+  portEXIT_CRITICAL(&historyMux);
+
+  // short: the heap ran out before the ring reached its 2 hour size
+  snprintf(json, sizeof(json),
+           "{\"blocks\":%u,\"targetBlocks\":%u,\"short\":%s,\"blockSize\":%u,\"bytes\":%lu,\"samples\":%lu,"
+           "\"oldest\":%lu,\"newest\":%lu,\"now\":%lu,\"interval\":%lu}",
+           history.count, HISTORY_BLOCKS, history.count < HISTORY_BLOCKS ? "true" : "false", HISTORY_BLOCK_SIZE,
+           bytes, samples, (unsigned long)oldestTime, (unsigned long)newestTime, millis(), historyIntervalMs);
+  request->send(200, "application/json", json);
+}
+
+void handleSetHistoryRate(AsyncWebServerRequest *request) {
+  long ms = request->arg("ms").toInt();
+  if (ms < 100 || ms > 60000) {
+    request->send(400, "text/plain", "ms must be 100..60000");
+    return;
+  }
+  historyIntervalMs = ms;
+  portENTER_CRITICAL(&settingsMux);
+  settings.historyIntervalMs = ms;
+  portEXIT_CRITICAL(&settingsMux);
+  settingsDirty = true;
+  request->send(200, "text/plain", String(historyIntervalMs));
+}
+
+// ===Requests that have to wait for loop()===
+// Anything slow or that uses the UART is only flagged here and done by
+// loop(), so the request gets its answer straight away.
+volatile bool relayCycleRequested = false;
+volatile bool wifiReconnectRequested = false;
+
+void handleRestartServer(AsyncWebServerRequest *request) {
+  relayCycleRequested = true; // loop() asks the AVR128 to power cycle the relay and the ESP32
+  request->send(200, "text/plain", "Restarting");
+}
 
-void handleRestartServer() {
-  SerialPort.print("z\r\n");
+void handleWifiReconnect(AsyncWebServerRequest *request) {
+  wifiReconnectRequested = true; // loop() starts over with the saved networks
+  request->send(200, "text/plain", "Reconnecting");
 }
 
 // ===Functions to request information from the ESP32===
-void handleIpAddress() {
+void handleIpAddress(AsyncWebServerRequest *request) {
   String ipAddressValue = WiFi.localIP().toString(); // Get required information
-  server.send(200, "text/plane", ipAddressValue);  // Send information to client side via HTTP request
+  request->send(200, "text/plane", ipAddressValue);  // Send information to client side via HTTP request
 }
 
 // Following functions are similiar to the first function
 
-void handleCurrentDNSValue() {
+void handleCurrentDNSValue(AsyncWebServerRequest *request) {
   String dnsValue = WiFi.dnsIP().toString();
-  server.send(200, "text/plane", dnsValue);
+  request->send(200, "text/plane", dnsValue);
 }
 
-void handleNetMaskValue() {
+void handleNetMaskValue(AsyncWebServerRequest *request) {
   String subNetMaskValue = WiFi.subnetMask().toString();
-  server.send(200, "text/plane", subNetMaskValue);
+  request->send(200, "text/plane", subNetMaskValue);
 }
 
-void handleMACValue() {
+void handleMACValue(AsyncWebServerRequest *request) {
   String macAddressValue = WiFi.macAddress();
-  server.send(200, "text/plane", macAddressValue);
+  request->send(200, "text/plane", macAddressValue);
 }
 
-// ===Following funtions are used to store WiFi Credentials in the EEPROM===
+// ===Settings kept in EEPROM (see settings.h)===
+// setup() loads the record once. Handlers change the RAM copy under
+// settingsMux and set settingsDirty; loop() writes it back, so a request never
+// waits on the EEPROM commit.
+
+// Called from loop()
+void settingsSync() {
+  Settings copy;
 
-void storeStringToEEPROM(String str) {
-  int len = str.length() + 1; // Include null character
-  for (int i = 0; i < len; i++) { // Write each character of the string to the EEPROM
-    EEPROM.write(i, str.charAt(i));
+  if (!settingsDirty) {
+    return;
   }
-  EEPROM.commit(); // Commit the EEPROM changes
+  settingsDirty = false;
+  portENTER_CRITICAL(&settingsMux);
+  copy = settings;
+  portEXIT_CRITICAL(&settingsMux);
+  settingsSave(copy);
 }
 
-
-String loadStringFromEEPROM() {
-  String result;
-  char c;
-  int i = 0;
-  do { // Read each character from the EEPROM
-    c = EEPROM.read(i++);
-    if (c != '\0') {
-      result += c;
+// Append text as a JSON string, escaping what needs it
+size_t appendJsonString(char *out, size_t size, size_t pos, const char *text) {
+  if (pos < size) out[pos++] = '"';
+  for (; *text != '\0' && pos + 7 < size; text++) {
+    unsigned char c = *text;
+    if (c == '"' || c == '\\') {
+      out[pos++] = '\\';
+      out[pos++] = c;
+    } else if (c < 0x20) {
+      pos += snprintf(out + pos, size - pos, "\\u%04x", c);
+    } else {
+      out[pos++] = c;
     }
-  } while (c != '\0' && i < EEPROM.length());
-  return result; // Return the string result from the EEPROM
+  }
+  if (pos < size) out[pos++] = '"';
+  if (pos < size) out[pos] = '\0';
+  return pos;
 }
 
 // Function to handle HTTPS Request to save new WiFi credentials
-void handleSaveCreds() {
-  //Serial.println("Save Button");
-  String storeWifiCreds = server.arg("data"); // extract the data from the request body
-  storeStringToEEPROM(storeWifiCreds); // Store the new credentials in the EEPROM
-  
-  server.send(200, "text/plain", "Data received"); // send a acknowldgment response to the client
+// saveWifiCreds?n1=&p1=&n2=&p2=&n3=&p3= (URL encoded, any of them may be empty)
+void handleSaveCreds(AsyncWebServerRequest *request) {
+  WifiSlot slots[WIFI_SLOTS];
+
+  for (int i = 0; i < WIFI_SLOTS; i++) {
+    String n = "n" + String(i + 1);
+    String p = "p" + String(i + 1);
+    strlcpy(slots[i].ssid, request->arg(n).c_str(), sizeof(slots[i].ssid));
+    strlcpy(slots[i].password, request->arg(p).c_str(), sizeof(slots[i].password));
+  }
+  portENTER_CRITICAL(&settingsMux);
+  memcpy(settings.wifi, slots, sizeof(settings.wifi));
+  portEXIT_CRITICAL(&settingsMux);
+  settingsDirty = true; // loop() writes the EEPROM
+
+  request->send(200, "text/plain", "Data received"); // send a acknowldgment response to the client
 }
 
 // Function to handle sending the WiFi credentials to the client
-void handleLoadCreds(){
-  String loadWifiCreds = loadStringFromEEPROM(); // Load the data from them EEPROM to a string
-  //Serial.println(loadWifiCreds); // print the received data to the Serial Monitor
+// {"networks":[{"ssid":"...","password":"..."},...]}
+void handleLoadCreds(AsyncWebServerRequest *request){
+  WifiSlot slots[WIFI_SLOTS];
+  char ssid[6 * sizeof(slots[0].ssid) + 3];
+  char password[6 * sizeof(slots[0].password) + 3];
+
+  portENTER_CRITICAL(&settingsMux);
+  memcpy(slots, settings.wifi, sizeof(slots));
+  portEXIT_CRITICAL(&settingsMux);
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->printf("{\"networks\":[");
+  for (int i = 0; i < WIFI_SLOTS; i++) {
+    appendJsonString(ssid, sizeof(ssid), 0, slots[i].ssid);
+    appendJsonString(password, sizeof(password), 0, slots[i].password);
+    response->printf("%s{\"ssid\":%s,\"password\":%s}", i ? "," : "", ssid, password);
+  }
+  response->printf("]}");
+  request->send(response); // Send the WiFi credential data to the client side.
+}
+
+// /setStaticIp?ip=&gateway=&mask=&dns=  sets the station address, no ip goes back to DHCP
+void handleSetStaticIp(AsyncWebServerRequest *request) {
+  IPAddress ip, gw, mask, dns;
+  bool useStatic = request->hasArg("ip") && request->arg("ip").length() > 0;
 
-  server.send(200, "text/plain", loadWifiCreds); // Send the WiFi credential data to the client side.
+  if (useStatic && (!ip.fromString(request->arg("ip").c_str()) ||
+                    !gw.fromString(request->arg("gateway").c_str()) ||
+                    !mask.fromString(request->arg("mask").c_str()))) {
+    request->send(400, "text/plain", "ip, gateway and mask are needed");
+    return;
+  }
+  if (useStatic && !dns.fromString(request->arg("dns").c_str())) {
+    dns = gw;
+  }
+  portENTER_CRITICAL(&settingsMux);
+  settings.useStaticIp = useStatic;
+  settings.staticIp = useStatic ? (uint32_t)ip : 0;
+  settings.staticGateway = useStatic ? (uint32_t)gw : 0;
+  settings.staticMask = useStatic ? (uint32_t)mask : 0;
+  settings.staticDns = useStatic ? (uint32_t)dns : 0;
+  portEXIT_CRITICAL(&settingsMux);
+  settingsDirty = true;
+  request->send(200, "text/plain", useStatic ? "Static IP saved" : "DHCP");
 }
 
-// ===Function to use EEPROM credentials to connect to WiFi===
-void connectWifi(){
-  
-  //Serial.println("Reconnect Button Pressed");
-  
-  String loadWifiCreds = loadStringFromEEPROM(); // Load the EEPROM data to a string
-  char* credsPointer = const_cast<char*>(loadWifiCreds.c_str()); // Cast the string to a character pointer to be used by the strtok function
+// Everything in the settings record except the passwords
+void handleReadSettings(AsyncWebServerRequest *request) {
+  Settings s;
+  char json[300];
+
+  portENTER_CRITICAL(&settingsMux);
+  s = settings;
+  portEXIT_CRITICAL(&settingsMux);
+  snprintf(json, sizeof(json),
+           "{\"version\":%u,\"staticIp\":%s,\"ip\":\"%s\",\"gateway\":\"%s\",\"mask\":\"%s\",\"dns\":\"%s\","
+           "\"telemetryMs\":%u,\"pushMs\":%u,\"historyMs\":%u,\"cached\":%s}",
+           s.version, s.useStaticIp ? "true" : "false", IPAddress(s.staticIp).toString().c_str(),
+           IPAddress(s.staticGateway).toString().c_str(), IPAddress(s.staticMask).toString().c_str(),
+           IPAddress(s.staticDns).toString().c_str(), s.telemetryRefreshMs, s.pushIntervalMs,
+           s.historyIntervalMs, s.wifiCache.valid ? "true" : "false");
+  request->send(200, "application/json", json);
+}
 
-  char *credentials[6]; // Character array to store 3 network name and password pairs
-  char *token = strtok(credsPointer, ","); // Use strtok to seperate the wifi credentials by commans (the credentials are stored as commma seperated list)
+// ===Wi-Fi connection state machine===
+// wifiPoll() in loop() brings the station link up without ever blocking, so
+// the server and the access point are up from the start of setup() and the
+// config page stays reachable while Wi-Fi comes up.
+//
+// The first try after boot (or after losing the network) goes straight to
+// the BSSID and channel that worked last time, with the IP address it got,
+// skipping the scan and DHCP. If that does not come up quickly each saved
+// network is tried in turn with a full scan and DHCP. Once all of them have
+// failed the machine waits, doubling the wait after every failed round up to
+// WIFI_BACKOFF_MAX_MS, then starts over.
+//
+// The access point runs whenever the station is not connected, and is shut
+// off once it is, as before.
+
+#define WIFI_FAST_TIMEOUT_MS    3000    // Cached BSSID/channel/IP attempt
+#define WIFI_CONNECT_TIMEOUT_MS 10000   // Attempt with a scan and DHCP
+#define WIFI_BACKOFF_MIN_MS     1000
+#define WIFI_BACKOFF_MAX_MS     60000
+
+enum WifiState {
+  WIFI_IDLE,        // No networks saved, access point only
+  WIFI_START,       // Pick the first network to try
+  WIFI_CONNECTING,  // Waiting on WiFi.begin()
+  WIFI_CONNECTED,
+  WIFI_BACKOFF      // Every network failed, wait before the next round
+};
+
+WifiSlot wifiSlots[WIFI_SLOTS];    // Copy of settings.wifi taken by wifiRestart()
+WifiState wifiState = WIFI_START;
+int wifiSlot = -1;                  // Slot being tried, -1 while on the cached fast path
+unsigned long wifiStateAt = 0;      // When wifiState was entered
+unsigned long wifiBackoffMs = WIFI_BACKOFF_MIN_MS;
+unsigned int wifiFailures = 0;      // Failed rounds in a row
+bool wifiEverConnected = false;
+
+// Remember the network we are on, the EEPROM is only written if something changed
+void saveWifiCache(int slot) {
+  WifiCache cache;
+
+  memset(&cache, 0, sizeof(cache));
+  cache.valid = 1;
+  strlcpy(cache.ssid, wifiSlots[slot].ssid, sizeof(cache.ssid));
+  memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+  cache.channel = WiFi.channel();
+  cache.ip = WiFi.localIP();
+  cache.gateway = WiFi.gatewayIP();
+  cache.mask = WiFi.subnetMask();
+  cache.dns = WiFi.dnsIP();
+  portENTER_CRITICAL(&settingsMux);
+  if (memcmp(&cache, &settings.wifiCache, sizeof(cache)) != 0) {
+    settings.wifiCache = cache;
+    settingsDirty = true;
+  }
+  portEXIT_CRITICAL(&settingsMux);
+}
 
-  for (int i = 0; i < 6; i++){
-    credentials[i] = token;  // Store each substring in the character array
-    token = strtok(NULL, ","); // Retrieve the next substring
+// Next slot after the given one that has a network saved, WIFI_SLOTS if none
+int wifiNextSlot(int after) {
+  for (int slot = after + 1; slot < WIFI_SLOTS; slot++) {
+    if (wifiSlots[slot].ssid[0] != '\0') {
+      return slot;
+    }
   }
+  return WIFI_SLOTS;
+}
 
-   // Try each of the WiFi credentials
-  for (int j = 0; j < 3; j++) {
-    WiFi.begin(credentials[j], credentials[j+1]); // Try the network name and password pair
-    delay(2000); // Provide a delay to see if the ESP32 connects to the the 
-    
-    // ASSIGNS STATIC IP TO ESP32 WHEN IT CONNECTS TO WIFI
-    //WiFi.config(local_ip, gateway, subnet); Commented out until we can set up a static IP with the router
-    
-    
-    if (WiFi.isConnected()) { // If the WiFi is connected do the following
+// Slot the cached network belongs to, -1 if the cache is empty or stale
+int wifiCachedSlot() {
+  if (!settings.wifiCache.valid) {
+    return -1;
+  }
+  for (int slot = 0; slot < WIFI_SLOTS; slot++) {
+    if (wifiSlots[slot].ssid[0] != '\0' && strcmp(wifiSlots[slot].ssid, settings.wifiCache.ssid) == 0) {
+      return slot;
+    }
+  }
+  return -1;
+}
+
+void wifiEnter(WifiState state) {
+  wifiState = state;
+  wifiStateAt = millis();
+}
+
+void startAccessPoint() {
+  WiFi.mode(WIFI_AP_STA);
+  WiFi.softAP("MyESP32AP", "MyAPPassword"); // Establish Access Point with ssid and password needed to connect
+  WiFi.softAPConfig(local_ip, gateway, subnet); // Establish IP configuration
+}
+
+// Try one saved network, or the cached fast path when slot is -1
+void wifiAttempt(int slot) {
+  Settings s;
+
+  portENTER_CRITICAL(&settingsMux);
+  s = settings;
+  portEXIT_CRITICAL(&settingsMux);
+
+  wifiSlot = slot;
+  if (s.useStaticIp) { // ASSIGNS STATIC IP TO ESP32 WHEN IT CONNECTS TO WIFI
+    WiFi.config(IPAddress(s.staticIp), IPAddress(s.staticGateway), IPAddress(s.staticMask),
+                IPAddress(s.staticDns));
+  } else if (slot < 0) { // The address DHCP gave out last time
+    WiFi.config(IPAddress(s.wifiCache.ip), IPAddress(s.wifiCache.gateway), IPAddress(s.wifiCache.mask),
+                IPAddress(s.wifiCache.dns));
+  } else {
+    WiFi.config(IPAddress(), IPAddress(), IPAddress()); // 0.0.0.0 puts DHCP back after a fast path try
+  }
+  if (slot < 0) {
+    int cached = wifiCachedSlot();
+    WiFi.begin(wifiSlots[cached].ssid, wifiSlots[cached].password, s.wifiCache.channel, s.wifiCache.bssid);
+  } else {
+    WiFi.begin(wifiSlots[slot].ssid, wifiSlots[slot].password);
+  }
+  wifiEnter(WIFI_CONNECTING);
+}
+
+// Take a fresh copy of the saved networks
+void loadWifiSlots() {
+  portENTER_CRITICAL(&settingsMux);
+  memcpy(wifiSlots, settings.wifi, sizeof(wifiSlots));
+  portEXIT_CRITICAL(&settingsMux);
+}
+
+// Forget where we were and start over with the saved networks, e.g. after new credentials
+void wifiRestart() {
+  loadWifiSlots();
+  wifiFailures = 0;
+  wifiBackoffMs = WIFI_BACKOFF_MIN_MS;
+  WiFi.disconnect();
+  if (wifiState == WIFI_CONNECTED) {
+    startAccessPoint();
+  }
+  wifiEnter(WIFI_START);
+}
+
+// Called from loop(), never blocks
+void wifiPoll() {
+  unsigned long now = millis();
+
+  switch (wifiState) {
+  case WIFI_IDLE:
+    break;
+
+  case WIFI_START:
+    if (wifiCachedSlot() >= 0) {
+      wifiAttempt(-1);
+    } else if (wifiNextSlot(-1) < WIFI_SLOTS) {
+      wifiAttempt(wifiNextSlot(-1));
+    } else {
+      webpage = PAGE_CONFIG; // Nothing saved, the user has to come in over the access point
+      wifiEnter(WIFI_IDLE);
+    }
+    break;
+
+  case WIFI_CONNECTING: {
+    wl_status_t status = WiFi.status();
+    unsigned long timeout = (wifiSlot < 0) ? WIFI_FAST_TIMEOUT_MS : WIFI_CONNECT_TIMEOUT_MS;
+
+    if (status == WL_CONNECTED) {
+      if (wifiSlot < 0) {
+        wifiSlot = wifiCachedSlot();
+      }
+      saveWifiCache(wifiSlot);
       WiFi.softAPdisconnect(true); // Disable the ESP32 Access Point mode
       Serial.println("SoftAP disabled");
-      break; // break to not try the other WiFi credentials
+      Serial.print("IP address: ");
+      Serial.println(WiFi.localIP());  //IP address assigned to your ESP
+      wifiFailures = 0;
+      wifiBackoffMs = WIFI_BACKOFF_MIN_MS;
+      wifiEverConnected = true;
+      wifiEnter(WIFI_CONNECTED);
+    } else if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL || now - wifiStateAt > timeout) {
+      WiFi.disconnect();
+      int next = wifiNextSlot(wifiSlot);
+      if (next < WIFI_SLOTS) {
+        wifiAttempt(next);
+      } else { // Every network failed this round
+        wifiFailures++;
+        wifiBackoffMs = min((unsigned long)WIFI_BACKOFF_MIN_MS << min(wifiFailures - 1, 6u),
+                            (unsigned long)WIFI_BACKOFF_MAX_MS);
+        if (!wifiEverConnected && wifiFailures == 1) {
+          webpage = PAGE_CONFIG; // Change the webpage default to the config pagge
+          Serial.println("Failed to connect to WiFi network!");
+          Serial.print("Connect to: ");
+          Serial.println(WiFi.softAPIP());
+        }
+        wifiEnter(WIFI_BACKOFF);
+      }
+    }
+    break;
+  }
+
+  case WIFI_CONNECTED:
+    if (WiFi.status() != WL_CONNECTED) {
+      Serial.println("WiFi lost, access point back on");
+      startAccessPoint();
+      wifiEnter(WIFI_START); // Fast path first, it is most likely the same network
     }
+    break;
+
+  case WIFI_BACKOFF:
+    if (now - wifiStateAt >= wifiBackoffMs) {
+      wifiEnter(WIFI_START);
+    }
+    break;
   }
 }
 
@@ -330,37 +1362,55 @@ void connectWifi(){
 //===============================================================
 
 void setup(void){
-  EEPROM.begin(250); // Establish the needed EEPROM size
+  EEPROM.begin(SETTINGS_EEPROM_SIZE); // Establish the needed EEPROM size
+  bool settingsCurrent = settingsLoad(settings);
+  if (!settingsCurrent) {
+    settingsSave(settings); // First boot, or converted from the old credential string
+  }
+  telemetryRefreshMs = settings.telemetryRefreshMs;
+  pushIntervalMs = settings.pushIntervalMs;
+  historyIntervalMs = settings.historyIntervalMs;
+  historyBegin(history); // Claim the history ring before anything fragments the heap
 
   pinMode(inputThresholdPin, INPUT); // Set GPIO pin that connects to AVR PORTG Pin 3 that signifies threshold to input
 
   Serial.begin(115200); // Define the serial BAUD Rate
   SerialPort.begin(115200, SERIAL_8N1, 39, 40);  // Establish the BAUD Rate, Standard, and GPIO pins
+  xTaskCreatePinnedToCore(acquisitionTask, "acquisition", 4096, NULL, ACQUISITION_PRIORITY, NULL,
+                          ACQUISITION_CORE); // Owns SerialPort from here on
   Serial.println();
   Serial.println("Booting Sketch...");
+  Serial.println(settingsCurrent ? "Settings loaded" : "Settings written");
+  if (history.count < HISTORY_BLOCKS) {
+    Serial.printf("History ring short of heap: %u of %u blocks, about %lu of %u minutes\n", history.count,
+                  HISTORY_BLOCKS, (unsigned long)history.count * HISTORY_TARGET_S / HISTORY_BLOCKS / 60,
+                  HISTORY_TARGET_S / 60);
+  }
+
+  // Trip log, formats the partition the first time
+  if (LittleFS.begin(true)) {
+    tripLogBegin(tripLog);
+    tripLogQueue = xQueueCreate(TRIPLOG_QUEUE_DEPTH, sizeof(TripLogMessage));
+  }
+  if (tripLogQueue != NULL) {
+    // Flash writes run on core 0 next to the Wi-Fi stack, away from loop()
+    xTaskCreatePinnedToCore(tripLogTask, "tripLog", 4096, NULL, 1, NULL, 0);
+    Serial.printf("Trip log: next trip %lu, %lu of %lu bytes used\n", (unsigned long)tripLog.nextTrip,
+                  (unsigned long)LittleFS.usedBytes(), (unsigned long)LittleFS.totalBytes());
+  } else {
+    Serial.println("Trip log not available");
+  }
 
 
   //ESP32 connects to your wifi -----------------------------------
-  WiFi.mode(WIFI_STA); //Establish WiFi mode
-  connectWifi(); // Try connecting to the saved WiFi Credentials
-
-  // If connection failed, switch to AP mode
-  if (WiFi.status() != WL_CONNECTED) {
-    webpage = "config"; // Change the webpage default to the config pagge
-    Serial.println("Failed to connect to WiFi network!");
-    WiFi.disconnect(); // Disconnect WiFi
-    WiFi.softAP("MyESP32AP", "MyAPPassword"); // Establish Access Point with ssid and password needed to connect
-    WiFi.softAPConfig(local_ip, gateway, subnet); // Establish IP configuration
-    Serial.println("Access point mode activated!");
-    Serial.print("Connect to: ");
-    Serial.println(WiFi.softAPIP());
-  } else{
-    //If connection successful show IP address in serial monitor
-    
-    Serial.println("");
-    Serial.print("IP address: ");
-    Serial.println(WiFi.localIP());  //IP address assigned to your ESP
-  }
+  // Access point straight away, wifiPoll() in loop() brings up the station side
+  WiFi.persistent(false); // The credentials live in our EEPROM, not the SDK's flash
+  WiFi.setAutoReconnect(false); // wifiPoll() does the reconnecting
+  startAccessPoint();
+  loadWifiSlots();
+  Serial.println("Access point mode activated!");
+  Serial.print("Connect to: ");
+  Serial.println(WiFi.softAPIP());
 
   
     
@@ -369,39 +1419,53 @@ void setup(void){
  
 
   // HTTPS Request Function Handlers
-  server.on("/", handleRoot);      //This is display page
-
-  server.on("/readPackVoltage", handlePackVoltage);
-  server.on("/readPackCurrent", handlePackCurrent);
-  server.on("/readSOCValue", handlePackSOC);
-  server.on("/readPowerValue", handlePackPower);
-  server.on("/readvoltageValue1", handleVoltageValue1);
-  server.on("/readvoltageValue2", handleVoltageValue2);
-  server.on("/readvoltageValue3", handleVoltageValue3);
-
-  server.on("/readMotorValue", handleMotorValue);
-  server.on("/readControllerValue", handleControllerValue);
-  server.on("/readDCDCValue", handleDCDCValue);
-  server.on("/readBBoxValue1", handleBBoxValue1);
-  server.on("/readBBoxValue2", handleBBoxValue2);
-  server.on("/readAmbientValue", handleAmbientValue);
-
-  server.on("/readIpAddressValue", handleIpAddress);
-  server.on("/readDNSValue", handleCurrentDNSValue);
-  server.on("/readNetMaskValue", handleNetMaskValue);
-  server.on("/readMACValue", handleMACValue);
-
-  server.on("/readRestartServer", handleRestartServer);
-
-  server.on("/readConfigPage", handleConfigPage);
-  server.on("/readRemotePage", handleRemotePage);
-  server.on("/readWifiCredPage", handleWifiCredPage);
-
-  server.on("/saveWifiCreds", handleSaveCreds);
-  server.on("/readNetworkCreds", handleLoadCreds);
-  server.on("/readThreshold", handleThreshold);
-
-  server.on("/readWifiReconnect", connectWifi);
+  server.on("/", HTTP_GET, handleRoot);      //This is display page
+
+  server.on("/readPackVoltage", HTTP_GET, handlePackVoltage);
+  server.on("/readPackCurrent", HTTP_GET, handlePackCurrent);
+  server.on("/readSOCValue", HTTP_GET, handlePackSOC);
+  server.on("/readPowerValue", HTTP_GET, handlePackPower);
+  server.on("/readvoltageValue1", HTTP_GET, handleVoltageValue1);
+  server.on("/readvoltageValue2", HTTP_GET, handleVoltageValue2);
+  server.on("/readvoltageValue3", HTTP_GET, handleVoltageValue3);
+
+  server.on("/readMotorValue", HTTP_GET, handleMotorValue);
+  server.on("/readControllerValue", HTTP_GET, handleControllerValue);
+  server.on("/readDCDCValue", HTTP_GET, handleDCDCValue);
+  server.on("/readBBoxValue1", HTTP_GET, handleBBoxValue1);
+  server.on("/readBBoxValue2", HTTP_GET, handleBBoxValue2);
+  server.on("/readAmbientValue", HTTP_GET, handleAmbientValue);
+
+  server.on("/readIpAddressValue", HTTP_GET, handleIpAddress);
+  server.on("/readDNSValue", HTTP_GET, handleCurrentDNSValue);
+  server.on("/readNetMaskValue", HTTP_GET, handleNetMaskValue);
+  server.on("/readMACValue", HTTP_GET, handleMACValue);
+
+  server.on("/readRestartServer", HTTP_GET, handleRestartServer);
+
+  server.on("/readConfigPage", HTTP_GET, handleConfigPage);
+  server.on("/readRemotePage", HTTP_GET, handleRemotePage);
+  server.on("/readWifiCredPage", HTTP_GET, handleWifiCredPage);
+
+  server.on("/saveWifiCreds", HTTP_ANY, handleSaveCreds);
+  server.on("/readNetworkCreds", HTTP_GET, handleLoadCreds);
+  server.on("/setStaticIp", HTTP_GET, handleSetStaticIp);
+  server.on("/readSettings", HTTP_GET, handleReadSettings);
+  server.on("/setPollRate", HTTP_GET, handleSetPollRate);
+  server.on("/readThreshold", HTTP_GET, handleThreshold);
+  server.on("/readAll", HTTP_GET, handleReadAll);
+  server.on("/setPushRate", HTTP_GET, handleSetPushRate);
+  server.on("/history", HTTP_GET, handleHistory);
+  server.on("/historyInfo", HTTP_GET, handleHistoryInfo);
+  server.on("/setHistoryRate", HTTP_GET, handleSetHistoryRate);
+  server.on("/trips", HTTP_GET, handleTrips);
+  server.on("/trip", HTTP_GET, handleTrip);
+  server.on("/stats", HTTP_GET, handleStats);
+
+  server.on("/readWifiReconnect", HTTP_GET, handleWifiReconnect);
+
+  events.onConnect(onEventsConnect);
+  server.addHandler(&events);
  
   server.begin();                  //Start server
   Serial.println("HTTP server started");
@@ -413,6 +1477,21 @@ void setup(void){
 // This routine is executed when you open its IP in browser
 //===============================================================
 void loop(void){
-  server.handleClient(); // Hangle incoming client requests
+  // Client requests are handled by the async server's own task and the
+  // snapshot is kept fresh by the acquisition task
+  wifiPoll(); // Bring the Wi-Fi link up or back
+  settingsSync(); // Write changed settings to the EEPROM
+  pushEvents(); // Push changes to /events subscribers
+  historySample(); // Add to the telemetry history when it is due
+
+  if (relayCycleRequested) {
+    relayCycleRequested = false;
+    tripLogDrain(1000); // The relay takes the ESP32's power with it
+    relayCycleQueued = true; // The acquisition task sends it
+  }
+  if (wifiReconnectRequested) {
+    wifiReconnectRequested = false;
+    wifiRestart();
+  }
   delay(1);
 }
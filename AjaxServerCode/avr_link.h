@@ -0,0 +1,167 @@
+// ===Binary frame link to the AVR128 (SerialPort, 115200)===
+//
+//   SYNC  LEN  SEQ  TYPE  PAYLOAD[LEN]  CRC_L  CRC_H
+//
+// Same format as WMOS_AVR_Code/WMOS_AVR_Code/Dependencies/ESP32_ISR.h,
+// keep the two in step. The CRC is CRC-16/CCITT (poly 0x1021, start 0xFFFF)
+// over LEN..PAYLOAD and multi byte values are little-endian. A damaged frame
+// is dropped and the parser goes back to hunting for the next SYNC byte.
+
+#define AVR_SYNC               0xA5
+#define AVR_MAX_PAYLOAD        32
+#define AVR_FRAME_OVERHEAD     6     // SYNC, LEN, SEQ, TYPE and the CRC
+
+// Frame types (ESP32 -> AVR128), replies have AVR_TYPE_REPLY or'ed in
+#define AVR_TYPE_SNAPSHOT      0x01
+#define AVR_TYPE_RELAY_CYCLE   0x02
+#define AVR_TYPE_OLED_LINK     0x03
+#define AVR_TYPE_REPLY         0x80
+#define AVR_TYPE_NAK           0x7F
+
+// Snapshot reply payload offsets
+#define SNAP_PACK_VOLTAGE      0     // uint16  pack volts x100
+#define SNAP_PACK_CURRENT      2     // int16   pack amps x10
+#define SNAP_PACK_SOC          4     // uint16  SoC percent x10
+#define SNAP_PACK_KWH          6     // int32   pack Wh x10
+#define SNAP_AUX5              10    // uint16  volts x100
+#define SNAP_AUX12             12    // uint16  volts x100
+#define SNAP_ACCY133           14    // uint16  volts x100
+#define SNAP_TEMPS             16    // int16 x 6, tenths of a degree, Motor first
+#define SNAP_FLAGS             28    // uint8   AVR_FLAG_* bits
+#define AVR_SNAPSHOT_LEN       29
+
+// OLED link reply: uint32 baud per display, OLED1 first, 0 = not answering
+#define AVR_OLED_COUNT         3
+#define AVR_OLED_LINK_LEN      12
+
+// Bits of the SNAP_FLAGS byte
+#define AVR_FLAG_SOCH_OFFLINE  0x01
+#define AVR_FLAG_PACK_VOLTAGE  0x02
+#define AVR_FLAG_PACK_SOC95    0x04
+#define AVR_FLAG_CHARGE_CYCLE  0x08
+#define AVR_FLAG_EVIM_STATE    0x10
+#define AVR_FLAG_DSP_MODE      0x20
+#define AVR_FLAG_TAILITE       0x40
+
+uint16_t avrCrc16Update(uint16_t crc, uint8_t data) {
+  crc ^= (uint16_t)data << 8;
+  for (uint8_t i = 0; i < 8; i++) {
+    if (crc & 0x8000) {
+      crc = (crc << 1) ^ 0x1021;
+    } else {
+      crc <<= 1;
+    }
+  }
+  return crc;
+}
+
+// Build a frame into out (at least len + AVR_FRAME_OVERHEAD bytes), returns its length
+size_t avrBuildFrame(uint8_t *out, uint8_t type, uint8_t seq, const uint8_t *payload, uint8_t len) {
+  uint16_t crc = 0xFFFF;
+  size_t n = 0;
+
+  out[n++] = AVR_SYNC;
+  out[n++] = len;
+  out[n++] = seq;
+  out[n++] = type;
+  for (uint8_t i = 0; i < len; i++) {
+    out[n++] = payload[i];
+  }
+  for (size_t i = 1; i < n; i++) {
+    crc = avrCrc16Update(crc, out[i]);
+  }
+  out[n++] = crc & 0xFF;
+  out[n++] = crc >> 8;
+  return n;
+}
+
+// Receive side: feed it one byte at a time
+struct AvrFrameParser {
+  uint8_t state;
+  uint8_t len;
+  uint8_t seq;
+  uint8_t type;
+  uint8_t count;
+  uint16_t crc;
+  uint8_t payload[AVR_MAX_PAYLOAD];
+  unsigned long frames;      // Good frames received
+  unsigned long crcErrors;   // Frames dropped for a bad CRC
+};
+
+enum { AVR_RX_IDLE, AVR_RX_LEN, AVR_RX_SEQ, AVR_RX_TYPE, AVR_RX_PAYLOAD, AVR_RX_CRC_L, AVR_RX_CRC_H };
+
+// Returns true when data completes a good frame (len, seq, type and payload are then valid)
+bool avrParseByte(AvrFrameParser &p, uint8_t data) {
+  switch (p.state) {
+    case AVR_RX_IDLE:
+      if (data == AVR_SYNC) { // Anything else is noise between frames
+        p.crc = 0xFFFF;
+        p.state = AVR_RX_LEN;
+      }
+      return false;
+
+    case AVR_RX_LEN:
+      if (data > AVR_MAX_PAYLOAD) {
+        p.state = (data == AVR_SYNC) ? AVR_RX_LEN : AVR_RX_IDLE;
+        return false;
+      }
+      p.len = data;
+      p.count = 0;
+      p.crc = avrCrc16Update(p.crc, data);
+      p.state = AVR_RX_SEQ;
+      return false;
+
+    case AVR_RX_SEQ:
+      p.seq = data;
+      p.crc = avrCrc16Update(p.crc, data);
+      p.state = AVR_RX_TYPE;
+      return false;
+
+    case AVR_RX_TYPE:
+      p.type = data;
+      p.crc = avrCrc16Update(p.crc, data);
+      p.state = (p.len > 0) ? AVR_RX_PAYLOAD : AVR_RX_CRC_L;
+      return false;
+
+    case AVR_RX_PAYLOAD:
+      p.payload[p.count++] = data;
+      p.crc = avrCrc16Update(p.crc, data);
+      if (p.count >= p.len) {
+        p.state = AVR_RX_CRC_L;
+      }
+      return false;
+
+    case AVR_RX_CRC_L:
+      if (data != (p.crc & 0xFF)) {
+        p.crcErrors++;
+        p.state = AVR_RX_IDLE;
+        return false;
+      }
+      p.state = AVR_RX_CRC_H;
+      return false;
+
+    case AVR_RX_CRC_H:
+      p.state = AVR_RX_IDLE;
+      if (data != (p.crc >> 8)) {
+        p.crcErrors++;
+        return false;
+      }
+      p.frames++;
+      return true;
+  }
+  p.state = AVR_RX_IDLE;
+  return false;
+}
+
+// Little-endian payload readers
+uint16_t avrGetU16(const uint8_t *p) {
+  return p[0] | (uint16_t)p[1] << 8;
+}
+
+int16_t avrGetI16(const uint8_t *p) {
+  return (int16_t)avrGetU16(p);
+}
+
+int32_t avrGetI32(const uint8_t *p) {
+  return (int32_t)(avrGetU16(p) | (uint32_t)avrGetU16(p + 2) << 16);
+}
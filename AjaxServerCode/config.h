@@ -88,12 +88,38 @@ const char CONFIG_page[] PROGMEM = R"=====(
 
     <script>
 
-      setInterval(function() {
-        getIpAddress();
-        getDNSValue();
-        getNetMaskValue();
-        getMACValue();
-      }, 500); //2000mSeconds update rate
+      // The ESP32 pushes a "network" event when the settings change.
+      // Browsers without EventSource, or a full ESP32, fall back to polling.
+      var pollTimer = null;
+
+      function startPolling() {
+        if (pollTimer == null) {
+          pollTimer = setInterval(function() {
+            getIpAddress();
+            getDNSValue();
+            getNetMaskValue();
+            getMACValue();
+          }, 500); //500mSeconds update rate
+        }
+      }
+
+      if (!!window.EventSource) {
+        var source = new EventSource("events");
+        source.addEventListener("network", function(e) {
+          var network = JSON.parse(e.data);
+          document.getElementById("ipAddressValue").innerHTML = network.ip;
+          document.getElementById("currentDNSValue").innerHTML = network.dns;
+          document.getElementById("netMaskValue").innerHTML = network.mask;
+          document.getElementById("MACValue").innerHTML = network.mac;
+        }, false);
+        source.onerror = function() {
+          if (source.readyState == EventSource.CLOSED) {
+            startPolling();
+          }
+        };
+      } else {
+        startPolling();
+      }
       
       function getIpAddress() {
         var xhttp = new XMLHttpRequest();
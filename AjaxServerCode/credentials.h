@@ -135,23 +135,16 @@ const char CREDENTIAL_page[] PROGMEM = R"=====(
         
         xhttp.onreadystatechange = function() {
         if (this.readyState == 4 && this.status == 200) {
-          var creds = this.responseText;
+          var creds = JSON.parse(this.responseText);
           
           console.log("Data Retrieval: ");
           console.log(creds);
           
-          var credsArray = creds.split(",");
-
-          while(credsArray.length < 6){
-            credsArray = credsArray.concat("");
+          for (var i = 0; i < 3; i++) {
+            var network = creds.networks[i] || {ssid: "", password: ""};
+            document.getElementById("networkName" + (i + 1)).value = network.ssid;
+            document.getElementById("networkPassword" + (i + 1)).value = network.password;
           }
-          
-          document.getElementById("networkName1").value = credsArray[0];
-          document.getElementById("networkPassword1").value = credsArray[1];
-          document.getElementById("networkName2").value = credsArray[2];
-          document.getElementById("networkPassword2").value = credsArray[3];
-          document.getElementById("networkName3").value = credsArray[4];
-          document.getElementById("networkPassword3").value = credsArray[5];
 
         }
         };
@@ -169,14 +162,14 @@ const char CREDENTIAL_page[] PROGMEM = R"=====(
         }
         };
 
-        var data = document.getElementById("networkName1").value + "," +
-                  document.getElementById("networkPassword1").value + "," +
-                  document.getElementById("networkName2").value + "," +
-                  document.getElementById("networkPassword2").value + "," +
-                  document.getElementById("networkName3").value + "," +
-                  document.getElementById("networkPassword3").value;
+        // One parameter per field, encoded so commas and '&' in a password survive
+        var data = [];
+        for (var i = 1; i <= 3; i++) {
+          data.push("n" + i + "=" + encodeURIComponent(document.getElementById("networkName" + i).value));
+          data.push("p" + i + "=" + encodeURIComponent(document.getElementById("networkPassword" + i).value));
+        }
 
-        xhttp.open("GET", "saveWifiCreds?data=" + data, true);
+        xhttp.open("GET", "saveWifiCreds?" + data.join("&"), true);
         xhttp.send();
         //console.log(data);
       }
@@ -0,0 +1,335 @@
+// ===Telemetry history ring buffer===
+//
+// Keeps the last couple of hours of the telemetry snapshot in RAM so a drive
+// or a charge can be looked at afterwards. loop() appends one sample every
+// historyIntervalMs; /history streams a time range back out as CSV or as the
+// raw encoded blocks.
+//
+// Storage is a ring of fixed size blocks. Each block starts with a keyframe
+// (full sample) followed by delta records, so when the oldest block is
+// overwritten the rest can still be decoded. All numbers are LEB128 varints,
+// signed ones zigzag encoded first.
+//
+//   keyframe:  time (uint32 LE, ms since boot), valid mask, value per valid channel
+//   delta:     time step change in ms (signed, against the record before; the
+//              first after the keyframe against 0), changed mask, value delta
+//              per changed channel
+//
+// A channel that was not valid yet is reported as "changed" from 0 the first
+// time it arrives; once valid a snapshot value never goes invalid again.
+//
+// Driving, nearly every channel changes every second (pack V and A, Wh, the
+// aux voltages and the tenth degree temperatures). Measured against avr_emu
+// that is about 13.6 bytes a sample, keyframes included, so the ring is sized
+// for 2 hours at HISTORY_SAMPLE_BYTES with some margin: 422 blocks, ~113 KB
+// of heap, claimed HISTORY_CHUNK_BLOCKS at a time.
+
+#define HISTORY_CHANNELS     (TELEM_COUNT + 1)  // Every snapshot slot plus the AVR flags
+#define HISTORY_FLAGS        TELEM_COUNT        // Channel number of the flags
+#define HISTORY_BLOCK_SIZE   256
+#define HISTORY_TARGET_S     7200               // 2 hours at 1 Hz
+#define HISTORY_SAMPLE_BYTES 15                 // Measured 13.6, plus margin
+#define HISTORY_BLOCKS       ((HISTORY_TARGET_S * HISTORY_SAMPLE_BYTES + HISTORY_BLOCK_SIZE - 1) / HISTORY_BLOCK_SIZE)
+#define HISTORY_MIN_BLOCKS   8                  // Less than this and there is no history
+#define HISTORY_CHUNK_BLOCKS 16                 // Blocks per allocation, ~4.3 KB
+#define HISTORY_CHUNKS       ((HISTORY_BLOCKS + HISTORY_CHUNK_BLOCKS - 1) / HISTORY_CHUNK_BLOCKS)
+#define HISTORY_MAX_RECORD   (5 + 3 + HISTORY_CHANNELS * 5)
+
+struct HistoryBlock {
+  uint32_t seq;          // Increases by one for every block started, 0 = unused
+  uint32_t startTime;    // Time of the keyframe
+  uint16_t used;         // Bytes of data filled
+  uint16_t records;      // Samples in this block
+  uint8_t data[HISTORY_BLOCK_SIZE];
+};
+
+struct HistoryRing {
+  HistoryBlock *chunks[HISTORY_CHUNKS];  // HISTORY_CHUNK_BLOCKS blocks each
+  uint16_t count;        // Blocks actually allocated
+  uint16_t head;         // Block being filled
+  uint32_t nextSeq;
+  // Encoder state, the last sample written
+  long last[HISTORY_CHANNELS];
+  uint16_t lastValid;
+  uint32_t lastTime;
+  uint32_t lastStep;     // Time step of the last delta, 0 after a keyframe
+};
+
+HistoryBlock &historyBlock(const HistoryRing &ring, uint16_t slot) {
+  return ring.chunks[slot / HISTORY_CHUNK_BLOCKS][slot % HISTORY_CHUNK_BLOCKS];
+}
+
+// ---Varint helpers---
+
+uint32_t zigzag(long v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+long unzigzag(uint32_t v) {
+  return (long)(v >> 1) ^ -(long)(v & 1);
+}
+
+uint8_t putVarint(uint8_t *out, uint32_t v) {
+  uint8_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (v & 0x7F) | 0x80;
+    v >>= 7;
+  }
+  out[n++] = v;
+  return n;
+}
+
+// Returns bytes used, 0 if the varint runs past end
+uint8_t getVarint(const uint8_t *in, const uint8_t *end, uint32_t *v) {
+  uint32_t result = 0;
+  uint8_t n = 0;
+  while (in + n < end && n < 5) {
+    uint8_t b = in[n];
+    result |= (uint32_t)(b & 0x7F) << (7 * n);
+    n++;
+    if (!(b & 0x80)) {
+      *v = result;
+      return n;
+    }
+  }
+  return 0;
+}
+
+// ---Writing---
+
+// Allocate the ring a chunk at a time, so no single ~113 KB piece of heap is
+// needed. Keeps what it got if the heap runs out first; the caller reports a
+// ring short of HISTORY_BLOCKS. False if not even HISTORY_MIN_BLOCKS fit.
+bool historyBegin(HistoryRing &ring) {
+  ring.count = 0;
+  while (ring.count < HISTORY_BLOCKS) {
+    uint16_t n = HISTORY_BLOCKS - ring.count;
+    if (n > HISTORY_CHUNK_BLOCKS) {
+      n = HISTORY_CHUNK_BLOCKS;
+    }
+    HistoryBlock *chunk = (HistoryBlock *)calloc(n, sizeof(HistoryBlock));
+    if (chunk == NULL) {
+      break;
+    }
+    ring.chunks[ring.count / HISTORY_CHUNK_BLOCKS] = chunk;
+    ring.count += n;
+  }
+  if (ring.count < HISTORY_MIN_BLOCKS) {
+    for (uint16_t i = 0; i < ring.count; i += HISTORY_CHUNK_BLOCKS) {
+      free(ring.chunks[i / HISTORY_CHUNK_BLOCKS]);
+    }
+    ring.count = 0;
+    return false;
+  }
+  ring.head = 0;
+  ring.nextSeq = 1;
+  return true;
+}
+
+size_t historyEncodeKeyframe(uint8_t *out, const long *values, uint16_t valid, uint32_t now) {
+  size_t n = 0;
+  out[n++] = now & 0xFF;
+  out[n++] = (now >> 8) & 0xFF;
+  out[n++] = (now >> 16) & 0xFF;
+  out[n++] = now >> 24;
+  n += putVarint(out + n, valid);
+  for (int c = 0; c < HISTORY_CHANNELS; c++) {
+    if (valid & (1 << c)) {
+      n += putVarint(out + n, zigzag(values[c]));
+    }
+  }
+  return n;
+}
+
+size_t historyEncodeDelta(uint8_t *out, const HistoryRing &ring, const long *values, uint16_t valid, uint32_t now) {
+  uint16_t changed = 0;
+  size_t n = 0;
+
+  for (int c = 0; c < HISTORY_CHANNELS; c++) {
+    bool wasValid = ring.lastValid & (1 << c);
+    if ((valid & (1 << c)) && (!wasValid || values[c] != ring.last[c])) {
+      changed |= 1 << c;
+    }
+  }
+  n += putVarint(out + n, zigzag((int32_t)(now - ring.lastTime - ring.lastStep)));
+  n += putVarint(out + n, changed);
+  for (int c = 0; c < HISTORY_CHANNELS; c++) {
+    if (changed & (1 << c)) {
+      long previous = (ring.lastValid & (1 << c)) ? ring.last[c] : 0;
+      n += putVarint(out + n, zigzag(values[c] - previous));
+    }
+  }
+  return n;
+}
+
+// Append one sample, the caller holds whatever lock guards the ring.
+// Returns true when the sample did not fit and the block before head was
+// just finished.
+bool historyAppend(HistoryRing &ring, const long *values, uint16_t valid, uint32_t now) {
+  uint8_t record[HISTORY_MAX_RECORD];
+  HistoryBlock *block;
+  size_t n = 0;
+  bool finished = false;
+
+  if (ring.count == 0) {
+    return false;
+  }
+
+  block = &historyBlock(ring, ring.head);
+  if (block->seq != 0) {
+    n = historyEncodeDelta(record, ring, values, valid, now);
+  }
+  if (block->seq == 0 || block->used + n > HISTORY_BLOCK_SIZE) {
+    if (block->seq != 0) { // Full, move on and overwrite the oldest block
+      ring.head = (ring.head + 1) % ring.count;
+      block = &historyBlock(ring, ring.head);
+      finished = true;
+    }
+    block->seq = ring.nextSeq++;
+    block->startTime = now;
+    block->used = 0;
+    block->records = 0;
+    n = historyEncodeKeyframe(record, values, valid, now);
+    ring.lastStep = 0;
+  } else {
+    ring.lastStep = now - ring.lastTime;
+  }
+
+  memcpy(block->data + block->used, record, n);
+  block->used += n;
+  block->records++;
+  memcpy(ring.last, values, sizeof(ring.last));
+  ring.lastValid = valid;
+  ring.lastTime = now;
+  return finished;
+}
+
+// Finish the block being filled early, the next sample starts a new one
+void historyCloseBlock(HistoryRing &ring) {
+  if (ring.count == 0 || historyBlock(ring, ring.head).seq == 0) {
+    return;
+  }
+  ring.head = (ring.head + 1) % ring.count;
+  historyBlock(ring, ring.head).seq = 0;
+}
+
+// ---Binary export---
+// The layout /history?format=bin and the trip log files use:
+//   header:  "WMHB", version 2, channels, block size (uint16 LE)
+//   blocks:  seq (uint32 LE), start time (uint32 LE), used (uint16 LE), used bytes of data
+
+#define HISTORY_FILE_HEADER  8
+#define HISTORY_PACKED_MAX   (10 + HISTORY_BLOCK_SIZE)
+
+size_t historyPackHeader(uint8_t *out) {
+  const uint8_t header[HISTORY_FILE_HEADER] = {'W', 'M', 'H', 'B', 2, HISTORY_CHANNELS,
+                                               HISTORY_BLOCK_SIZE & 0xFF, HISTORY_BLOCK_SIZE >> 8};
+  memcpy(out, header, sizeof(header));
+  return sizeof(header);
+}
+
+size_t historyPackBlock(uint8_t *out, const HistoryBlock &b) {
+  uint8_t *p = out;
+  for (int i = 0; i < 4; i++) *p++ = b.seq >> (8 * i);
+  for (int i = 0; i < 4; i++) *p++ = b.startTime >> (8 * i);
+  *p++ = b.used & 0xFF;
+  *p++ = b.used >> 8;
+  memcpy(p, b.data, b.used);
+  return 10 + b.used;
+}
+
+// ---Reading---
+
+// Find the ring slot holding block seq, -1 if it is gone or not written yet
+int historyFindBlock(const HistoryRing &ring, uint32_t seq) {
+  if (ring.count == 0 || seq == 0) {
+    return -1;
+  }
+  uint32_t newest = historyBlock(ring, ring.head).seq;
+  if (seq > newest || newest - seq >= ring.count) {
+    return -1;
+  }
+  int slot = ((int)ring.head - (int)(newest - seq) + ring.count) % ring.count;
+  return historyBlock(ring, slot).seq == seq ? slot : -1;
+}
+
+uint32_t historyOldestSeq(const HistoryRing &ring) {
+  if (ring.count == 0) {
+    return 0;
+  }
+  uint32_t newest = historyBlock(ring, ring.head).seq;
+  if (newest == 0) {
+    return 0;
+  }
+  if (newest <= ring.count) {
+    return 1;
+  }
+  return newest - ring.count + 1;
+}
+
+// Walks the records of one block copied out of the ring
+struct HistoryDecoder {
+  HistoryBlock block;
+  uint16_t pos;
+  uint32_t time;
+  uint32_t step;         // Time step of the last delta
+  long values[HISTORY_CHANNELS];
+  uint16_t valid;
+};
+
+void historyDecodeStart(HistoryDecoder &d) {
+  d.pos = 0;
+  d.valid = 0;
+  d.time = d.block.startTime;
+  d.step = 0;
+}
+
+// Decode the next record of the block, false at the end of it
+bool historyDecodeNext(HistoryDecoder &d) {
+  const uint8_t *end = d.block.data + d.block.used;
+  const uint8_t *p = d.block.data + d.pos;
+  uint32_t v;
+  uint8_t n;
+
+  if (p >= end) {
+    return false;
+  }
+
+  if (d.pos == 0) { // Keyframe
+    if (end - p < 5) {
+      return false;
+    }
+    d.time = p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+    p += 4;
+    d.step = 0;
+    if ((n = getVarint(p, end, &v)) == 0) return false;
+    p += n;
+    d.valid = v;
+    for (int c = 0; c < HISTORY_CHANNELS; c++) {
+      d.values[c] = 0;
+      if (d.valid & (1 << c)) {
+        if ((n = getVarint(p, end, &v)) == 0) return false;
+        p += n;
+        d.values[c] = unzigzag(v);
+      }
+    }
+  } else { // Delta
+    if ((n = getVarint(p, end, &v)) == 0) return false;
+    p += n;
+    d.step += unzigzag(v);
+    d.time += d.step;
+    if ((n = getVarint(p, end, &v)) == 0) return false;
+    p += n;
+    uint16_t changed = v;
+    for (int c = 0; c < HISTORY_CHANNELS; c++) {
+      if (changed & (1 << c)) {
+        if ((n = getVarint(p, end, &v)) == 0) return false;
+        p += n;
+        d.values[c] += unzigzag(v);
+      }
+    }
+    d.valid |= changed;
+  }
+  d.pos = p - d.block.data;
+  return true;
+}
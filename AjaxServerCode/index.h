@@ -67,6 +67,12 @@ const char MAIN_page[] PROGMEM = R"=====(
       font-size: 60px;
       text-align: center;
     }
+    /* Age of each value in the ESP32 snapshot */
+    .age {
+      color: gray;
+      font-size: 25px;
+      margin-left: 10px;
+    }
   </style>
 </head>
 <body>
@@ -98,203 +104,137 @@ const char MAIN_page[] PROGMEM = R"=====(
 
     <script>
 
+      // The ESP32 pushes a "telemetry" event whenever the values change.
+      // Browsers without EventSource, or a full ESP32, fall back to polling.
+      var lastAll = null;     // Last telemetry received
+      var lastAllAt = 0;      // When it was received (page clock)
+      var pollTimer = null;
+
+      function startPolling() {
+        if (pollTimer == null) {
+          pollTimer = setInterval(getAllValues, 500); //500mSeconds update rate
+        }
+      }
+
+      if (!!window.EventSource) {
+        var source = new EventSource("events");
+        source.addEventListener("telemetry", function(e) {
+          showAll(JSON.parse(e.data));
+        }, false);
+        source.onerror = function() {
+          if (source.readyState == EventSource.CLOSED) {
+            startPolling();
+          }
+        };
+      } else {
+        startPolling();
+      }
+
+      // Keep the ages counting up between pushes
       setInterval(function() {
-        // Call a function repetatively with 2 Second interval
-        getPackVoltage();
-        getPackCurrent();
-        getPackSOC();
-        //getPackPower();
-        getVoltage1();
-        getVoltage2();
-        getVoltage3();
-        getMotorValue();
-        getControllerValue();
-        getDCDCValue();
-        getBBoxValue1();
-        getBBoxValue2();
-        getAmbientValue();
-        getThresholdValue();
-      }, 500); //1000mSeconds update rate
+        if (lastAll != null) {
+          refreshAll();
+        }
+      }, 500);
       
+      // Show a value and how long ago the ESP32 received it from the AVR128
+      function showValue(id, text, age) {
+        if (text == null) { // The ESP32 has not heard this value from the AVR128 yet
+          text = "---";
+        }
+        document.getElementById(id).innerHTML = text;
+
+        var ageElement = document.getElementById(id + "Age");
+        if (ageElement == null) { // Create the age label the first time
+          ageElement = document.createElement("span");
+          ageElement.id = id + "Age";
+          ageElement.className = "age";
+          document.getElementById(id).parentNode.appendChild(ageElement);
+        }
+
+        if (isNaN(age) || age < 0) {
+          ageElement.innerHTML = "(no data)";
+        } else {
+          ageElement.innerHTML = "(" + (age / 1000).toFixed(1) + " s)";
+        }
+      }
+
+      // Temperatures come over in tenths of a degree
+      function tenths(value) {
+        if (value == null) {
+          return null;
+        }
+        return (value / 10).toString();
+      }
+
       var thresholdSet = "";
       const THRESHOLD_VALUE = 178;
 
-      function getThresholdValue() {
-        
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            thresholdSet = this.responseText;
-            // Segement of code for threshold indication (i.e. beeping and color change)
-            //console.log(thresholdSet.localeCompare("LOW") == 0);
-            //console.log(parseInt((document.getElementById("packVoltageValue").innerHTML.slice(0,-1))) >= THRESHOLD_VALUE);
-            if ((thresholdSet.localeCompare("LOW")) == 0){
-              if(parseInt((document.getElementById("packVoltageValue").innerHTML.slice(0,-1))) >= THRESHOLD_VALUE){
-                document.getElementById("packVoltageValue").style.color = "red";
-                document.getElementById("divPackVoltageValue").style.color = "red";
-                // PUT AUDIO ALERT HERE
-                // PUT AUDIO ALERT HERE
-                // PUT AUDIO ALERT HERE
-                // PUT AUDIO ALERT HERE   
-
+      function showThreshold() {
+        // Segement of code for threshold indication (i.e. beeping and color change)
+        //console.log(thresholdSet.localeCompare("LOW") == 0);
+        //console.log(parseInt((document.getElementById("packVoltageValue").innerHTML.slice(0,-1))) >= THRESHOLD_VALUE);
+        if ((thresholdSet.localeCompare("LOW")) == 0){
+          if(parseInt((document.getElementById("packVoltageValue").innerHTML.slice(0,-1))) >= THRESHOLD_VALUE){
+            document.getElementById("packVoltageValue").style.color = "red";
+            document.getElementById("divPackVoltageValue").style.color = "red";
+            // PUT AUDIO ALERT HERE
+            // PUT AUDIO ALERT HERE
+            // PUT AUDIO ALERT HERE
+            // PUT AUDIO ALERT HERE   
 
 
-              } else {
-                document.getElementById("packVoltageValue").style.color = "blue";
-                document.getElementById("divPackVoltageValue").style.color = "blue";
-              }
-            } else {
-              document.getElementById("packVoltageValue").style.color = "blue";
-              document.getElementById("divPackVoltageValue").style.color = "blue";
-            }
 
+          } else {
+            document.getElementById("packVoltageValue").style.color = "blue";
+            document.getElementById("divPackVoltageValue").style.color = "blue";
           }
-        };
-        xhttp.open("GET", "readThreshold", true);
-        xhttp.send();
+        } else {
+          document.getElementById("packVoltageValue").style.color = "blue";
+          document.getElementById("divPackVoltageValue").style.color = "blue";
+        }
       }
 
-      function getPackVoltage() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("packVoltageValue").innerHTML =
-            this.responseText.slice(5);
-          }
-        };
-        xhttp.open("GET", "readPackVoltage", true);
-        xhttp.send();
-      }
-      function getPackCurrent() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("packCurrentValue").innerHTML =
-            this.responseText.slice(5);
-          }
-        };
-        xhttp.open("GET", "readPackCurrent", true);
-        xhttp.send();
-      }
-      function getPackSOC() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("packSOCValue").innerHTML =
-            this.responseText.slice(5);
-          }
-        };
-        xhttp.open("GET", "readSOCValue", true);
-        xhttp.send();
-      }
-      function getPackPower() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("packPowerValue").innerHTML =
-            this.responseText.slice(5);
-          }
-        };
-        xhttp.open("GET", "readPowerValue", true);
-        xhttp.send();
+      function showAll(all) {
+        lastAll = all;
+        lastAllAt = Date.now();
+        refreshAll();
       }
-      function getVoltage1() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("voltageValue1").innerHTML =
-            this.responseText;
-          }
-        };
-        xhttp.open("GET", "readvoltageValue1", true);
-        xhttp.send();
-      }
-      function getVoltage2() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("voltageValue2").innerHTML =
-            this.responseText;
-          }
-        };
-        xhttp.open("GET", "readvoltageValue2", true);
-        xhttp.send();
-      }
-      function getVoltage3() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("voltageValue3").innerHTML =
-            this.responseText;
-          }
-        };
-        xhttp.open("GET", "readvoltageValue3", true);
-        xhttp.send();
-      }
-      function getMotorValue() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("motorValue").innerHTML =
-            this.responseText;
-          }
-        };
-        xhttp.open("GET", "readMotorValue", true);
-        xhttp.send();
-      }
-      function getControllerValue() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("controllerValue").innerHTML =
-            this.responseText;
-          }
-        };
-        xhttp.open("GET", "readControllerValue", true);
-        xhttp.send();
-      }
-      function getDCDCValue() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("dcdcValue").innerHTML =
-            this.responseText;
-          }
-        };
-        xhttp.open("GET", "readDCDCValue", true);
-        xhttp.send();
-      }
-      function getBBoxValue1() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("bboxValue1").innerHTML =
-            this.responseText;
-          }
-        };
-        xhttp.open("GET", "readBBoxValue1", true);
-        xhttp.send();
-      }
-      function getBBoxValue2() {
-        var xhttp = new XMLHttpRequest();
-        xhttp.onreadystatechange = function() {
-          if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("bboxValue2").innerHTML =
-            this.responseText;
-          }
-        };
-        xhttp.open("GET", "readBBoxValue2", true);
-        xhttp.send();
+
+      function refreshAll() {
+        var all = lastAll;
+        var since = Date.now() - lastAllAt;
+        // Ages were taken when the ESP32 sent this, add the time since then
+        function age(i) {
+          return (all.age[i] < 0) ? -1 : all.age[i] + since;
+        }
+        // all.age is in the same order as the snapshot slots
+        showValue("packVoltageValue", all.v, age(0));
+        showValue("packCurrentValue", all.i, age(1));
+        showValue("packSOCValue", all.soc, age(2));
+        //showValue("packPowerValue", all.kwh, age(3));
+        showValue("voltageValue1", all.aux[0], age(4));
+        showValue("voltageValue2", all.aux[1], age(5));
+        showValue("voltageValue3", all.aux[2], age(6));
+        showValue("motorValue", tenths(all.t[0]), age(7));
+        showValue("controllerValue", tenths(all.t[1]), age(8));
+        showValue("dcdcValue", tenths(all.t[2]), age(9));
+        showValue("bboxValue1", tenths(all.t[3]), age(10));
+        showValue("bboxValue2", tenths(all.t[4]), age(11));
+        showValue("ambientValue", tenths(all.t[5]), age(12));
+
+        thresholdSet = all.th;
+        showThreshold();
       }
-      function getAmbientValue() {
+
+      function getAllValues() {
         var xhttp = new XMLHttpRequest();
         xhttp.onreadystatechange = function() {
           if (this.readyState == 4 && this.status == 200) {
-            document.getElementById("ambientValue").innerHTML =
-            this.responseText;
+            showAll(JSON.parse(this.responseText));
           }
         };
-        xhttp.open("GET", "readAmbientValue", true);
+        xhttp.open("GET", "readAll", true);
         xhttp.send();
       }
 
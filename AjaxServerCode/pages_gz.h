@@ -0,0 +1,279 @@
+// ===Gzipped web pages served from flash===
+// GENERATED by HostTools/page_gzip.c from the page headers, do not edit.
+// Re-run it whenever index.h, config.h or credentials.h changes.
+
+// index.h: 8632 bytes, 5736 minified, 1781 gzipped
+const uint8_t MAIN_page_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x58, 0xff, 0x6f, 0xda, 0x46,
+  0x14, 0xff, 0x9d, 0xbf, 0xe2, 0xea, 0x68, 0x95, 0x51, 0x03, 0x18, 0x27, 0x69, 0x52, 0x20, 0x4c,
+  0x94, 0xd0, 0xa5, 0x13, 0xf9, 0xa2, 0x40, 0xd3, 0x49, 0x55, 0x35, 0x1d, 0xf6, 0x81, 0x6f, 0x35,
+  0x3e, 0x66, 0x9f, 0x21, 0x6c, 0xcd, 0xff, 0xbe, 0xf7, 0xce, 0xdf, 0x0e, 0x03, 0x69, 0xbb, 0x6a,
+  0xda, 0xd6, 0x4a, 0x10, 0xdf, 0xbd, 0xcf, 0xe7, 0x7d, 0xbd, 0x7b, 0xcf, 0x74, 0x3c, 0x39, 0xf7,
+  0xbb, 0x95, 0x8e, 0xc7, 0xa8, 0x0b, 0x5f, 0x91, 0x5c, 0xfb, 0xac, 0x5b, 0x39, 0x98, 0xd0, 0x20,
+  0x60, 0x21, 0xf9, 0xb3, 0x32, 0xa1, 0xce, 0xa7, 0x59, 0x28, 0xe2, 0xc0, 0xad, 0x39, 0xc2, 0x17,
+  0x61, 0x8b, 0x1c, 0x1c, 0x37, 0x7b, 0x83, 0xc1, 0xa0, 0x5d, 0x49, 0x9f, 0x57, 0x1e, 0x97, 0xac,
+  0x5d, 0x91, 0xec, 0x41, 0xd6, 0xa8, 0xcf, 0x67, 0x41, 0x8b, 0x38, 0x2c, 0x90, 0x2c, 0x6c, 0x57,
+  0xa6, 0x22, 0x90, 0xb5, 0x88, 0xff, 0xc1, 0x5a, 0xe4, 0xd4, 0x5a, 0x3c, 0xb4, 0x2b, 0x0b, 0xea,
+  0xba, 0x3c, 0x98, 0xb5, 0xc8, 0xb1, 0x7a, 0x9c, 0x88, 0xd0, 0x65, 0x40, 0x11, 0x09, 0x9f, 0xbb,
+  0xc4, 0x5e, 0x3c, 0x90, 0x89, 0x0f, 0xfa, 0xb2, 0x8d, 0x5a, 0x48, 0x5d, 0x1e, 0x47, 0x2d, 0x72,
+  0x82, 0xc2, 0x73, 0x1a, 0xce, 0x78, 0x50, 0x9b, 0x08, 0x29, 0xc5, 0xbc, 0x45, 0x5e, 0x29, 0x86,
+  0x15, 0x77, 0xa5, 0xd7, 0x22, 0x4d, 0xcb, 0xfa, 0xa1, 0x5d, 0x79, 0xac, 0x1c, 0xf8, 0x3c, 0x92,
+  0xb5, 0x26, 0xd8, 0x9d, 0x1a, 0x37, 0xf1, 0x63, 0x96, 0x43, 0xa5, 0x58, 0xa0, 0x28, 0xe2, 0x7e,
+  0x8b, 0x23, 0xc9, 0xa7, 0x6b, 0xf0, 0x09, 0x2c, 0x0d, 0x64, 0x61, 0xb2, 0xf2, 0xa0, 0x06, 0x1e,
+  0xcd, 0xa3, 0x62, 0xf1, 0x0b, 0xbe, 0xbd, 0x54, 0x94, 0x99, 0x76, 0x1b, 0xb4, 0xbb, 0x3c, 0x5a,
+  0xf8, 0x74, 0xdd, 0x22, 0x53, 0x9f, 0x7d, 0xb3, 0xb6, 0x2f, 0x98, 0xbe, 0xa5, 0x78, 0x97, 0x75,
+  0xca, 0x98, 0x80, 0xa9, 0x50, 0xa4, 0xc1, 0xcc, 0x29, 0xd2, 0x70, 0xcf, 0x42, 0xba, 0xce, 0x03,
+  0x78, 0x86, 0xf1, 0x4b, 0x74, 0x25, 0xb4, 0x84, 0xc6, 0x52, 0x14, 0x3c, 0x76, 0x89, 0xc7, 0x2e,
+  0x78, 0xd2, 0x94, 0xed, 0x22, 0x6a, 0xea, 0x44, 0xf5, 0x49, 0x0c, 0x99, 0x0b, 0xfe, 0xa7, 0x35,
+  0x75, 0xb4, 0x9d, 0x55, 0xfc, 0xac, 0xb9, 0x3c, 0x64, 0x8e, 0xe4, 0x02, 0x2d, 0x14, 0x7e, 0x3c,
+  0x0f, 0xfe, 0xd1, 0xa4, 0xd6, 0xe9, 0x8c, 0x15, 0xc5, 0x9d, 0x64, 0x50, 0x83, 0xda, 0xba, 0x53,
+  0x3e, 0x9b, 0xca, 0x8c, 0xfe, 0xb1, 0xd2, 0x69, 0xa4, 0x47, 0xbb, 0xd3, 0x48, 0x8f, 0xfa, 0x44,
+  0xb8, 0x6b, 0xfc, 0x4a, 0xb2, 0xc2, 0xdd, 0x73, 0x23, 0x39, 0xf4, 0x06, 0x11, 0x81, 0xe3, 0x73,
+  0xe7, 0xd3, 0xb9, 0x31, 0x63, 0xb2, 0x2f, 0x82, 0x29, 0x9f, 0xdd, 0x82, 0x5e, 0xb3, 0x6a, 0x74,
+  0x07, 0xf7, 0x6f, 0xaf, 0xc8, 0x1d, 0x9b, 0x0b, 0xc9, 0x3a, 0x8d, 0x04, 0x09, 0x14, 0x2e, 0x5f,
+  0x2a, 0x7c, 0x72, 0xf8, 0x0c, 0x6d, 0x05, 0xbe, 0x6f, 0x21, 0xf8, 0xf7, 0xc2, 0x97, 0xc0, 0x70,
+  0x4f, 0xc1, 0x7b, 0xa3, 0x8b, 0x2b, 0x24, 0x5d, 0x6a, 0x91, 0x4e, 0xb4, 0xa0, 0x89, 0xfa, 0xc5,
+  0x96, 0xe4, 0xc5, 0xe0, 0x4d, 0xef, 0xdd, 0x70, 0x0c, 0xb6, 0x83, 0x4c, 0xb7, 0xd3, 0x00, 0xba,
+  0x6d, 0xf2, 0x7e, 0x1c, 0x86, 0x10, 0x20, 0x9d, 0x3c, 0x5d, 0x2a, 0x93, 0x6f, 0x4a, 0x7e, 0x15,
+  0xf9, 0xe8, 0xa6, 0xaf, 0x13, 0x8f, 0x44, 0xbf, 0x4c, 0x5a, 0x48, 0x6c, 0x10, 0xee, 0xe1, 0xbb,
+  0x15, 0x2b, 0x16, 0xea, 0x8c, 0x6a, 0xa1, 0xcc, 0xa9, 0x4b, 0xed, 0x36, 0xb3, 0xc4, 0x9e, 0x9c,
+  0x75, 0xa3, 0xbb, 0xbd, 0x8e, 0x17, 0x52, 0x29, 0x23, 0x7a, 0x8c, 0x9b, 0x06, 0x51, 0x75, 0x71,
+  0x6e, 0xa4, 0x55, 0x13, 0xf2, 0x99, 0x27, 0xd3, 0xb3, 0x04, 0x7c, 0xb9, 0x59, 0xcb, 0x0d, 0x50,
+  0xb7, 0xf9, 0xca, 0xba, 0x4f, 0x4d, 0x22, 0xf7, 0x3b, 0x7c, 0xd5, 0x75, 0xd8, 0x7f, 0x47, 0x87,
+  0x5d, 0xf6, 0xfc, 0x8b, 0x6a, 0x8e, 0xf6, 0x51, 0x1d, 0xed, 0xa7, 0xfa, 0x96, 0x30, 0x1e, 0x95,
+  0xc2, 0x78, 0x25, 0xa4, 0xc8, 0x92, 0xa4, 0xfe, 0xd6, 0xb3, 0x38, 0xd7, 0x36, 0x4b, 0xca, 0x9f,
+  0x1f, 0x9c, 0x1d, 0x9f, 0x9c, 0xee, 0x70, 0x06, 0x8e, 0x9a, 0x0c, 0x85, 0xef, 0xe7, 0xa9, 0x2f,
+  0x16, 0x74, 0x6a, 0xa7, 0x2c, 0xf6, 0xb5, 0xfc, 0x17, 0xfd, 0x8b, 0xbc, 0x54, 0xfb, 0xb5, 0x8b,
+  0x8d, 0x4a, 0x76, 0x1d, 0xd7, 0xf9, 0x1a, 0xba, 0xef, 0x09, 0xd8, 0xeb, 0xd7, 0xe2, 0x21, 0xab,
+  0x1f, 0xfc, 0x9b, 0x34, 0x75, 0x0b, 0x26, 0x93, 0x62, 0xb7, 0x64, 0xc2, 0x0e, 0x5f, 0x72, 0x2e,
+  0x3b, 0xe5, 0xb2, 0x77, 0x72, 0xd9, 0x5f, 0xc3, 0xd5, 0x9b, 0x4f, 0x78, 0x71, 0x2d, 0xa4, 0x4f,
+  0x3a, 0x1d, 0xdd, 0x10, 0xd8, 0x43, 0x98, 0x7e, 0x45, 0x4e, 0xc8, 0x17, 0xb2, 0x5b, 0x59, 0xd2,
+  0x90, 0xf8, 0x34, 0x92, 0x3d, 0xdf, 0x27, 0xe7, 0x24, 0x88, 0x7d, 0xbf, 0x4d, 0xf0, 0x5f, 0xa3,
+  0x41, 0x86, 0xb0, 0x4c, 0x24, 0xf3, 0xd9, 0x9c, 0xc9, 0x70, 0x4d, 0xa0, 0x7f, 0x30, 0xbe, 0x64,
+  0xae, 0x0e, 0xe9, 0x49, 0x00, 0x59, 0x09, 0x02, 0x21, 0xef, 0x3d, 0x06, 0xa6, 0x48, 0xb2, 0xa2,
+  0x51, 0x2e, 0x4f, 0xcc, 0x05, 0x76, 0x03, 0xc7, 0x17, 0xce, 0xa7, 0xaa, 0x02, 0x2f, 0xa0, 0x2a,
+  0xc6, 0x7c, 0x0e, 0x73, 0x5b, 0xaa, 0xb1, 0x32, 0x8d, 0x03, 0xd5, 0x9c, 0xe0, 0x00, 0xd2, 0x50,
+  0xde, 0xc2, 0x3e, 0x74, 0x4a, 0xb3, 0x0a, 0x2d, 0x84, 0x4f, 0x01, 0x5f, 0xc8, 0x27, 0x00, 0xdc,
+  0xd0, 0x49, 0x22, 0x26, 0xdf, 0x62, 0xeb, 0x59, 0x52, 0xdf, 0x84, 0x5e, 0x00, 0x86, 0xa9, 0x18,
+  0x44, 0x87, 0xe4, 0xc4, 0xb2, 0xaa, 0x6d, 0xb0, 0x0c, 0xbe, 0xe7, 0x23, 0x06, 0x25, 0xe9, 0x46,
+  0x24, 0x5e, 0xb8, 0x54, 0x32, 0x12, 0xc2, 0x07, 0x34, 0x9c, 0x47, 0xa5, 0xe2, 0xd9, 0xb3, 0x15,
+  0x0f, 0x5c, 0xb1, 0xaa, 0x0f, 0x96, 0x10, 0xc1, 0x91, 0x88, 0x43, 0x87, 0xa1, 0x16, 0x34, 0x37,
+  0x52, 0x4f, 0x68, 0x2b, 0x5b, 0x11, 0x6d, 0xdf, 0x34, 0x18, 0x3e, 0x44, 0x46, 0xb5, 0x5d, 0x49,
+  0x64, 0xea, 0xd0, 0xe2, 0x95, 0xc0, 0x10, 0xea, 0x8a, 0x41, 0x8f, 0x32, 0x8d, 0x3c, 0x7e, 0xc6,
+  0x21, 0xc9, 0xbc, 0x34, 0x15, 0x75, 0xe4, 0x89, 0x15, 0x58, 0x6a, 0xfe, 0x3c, 0xba, 0xb9, 0xae,
+  0x2f, 0x68, 0x18, 0x31, 0x93, 0xd5, 0xc1, 0x32, 0x5a, 0x05, 0xbe, 0x47, 0x90, 0xa6, 0x7e, 0xc4,
+  0x0a, 0x6a, 0x01, 0x74, 0xa1, 0x40, 0x6f, 0x73, 0x9a, 0x2c, 0x3e, 0xa9, 0x44, 0x08, 0xfd, 0x72,
+  0x3d, 0x92, 0xe8, 0x1b, 0xc4, 0x49, 0x33, 0xb4, 0xde, 0x1f, 0xde, 0x8c, 0x06, 0x17, 0x4a, 0xe9,
+  0x46, 0x7c, 0xb1, 0xe1, 0x3e, 0xc2, 0x07, 0x61, 0xa0, 0x6a, 0xe7, 0xae, 0x1e, 0xd9, 0x2d, 0xbd,
+  0x59, 0xdd, 0x3c, 0x2b, 0xb2, 0x12, 0xb2, 0x69, 0xc8, 0x22, 0x0f, 0xfd, 0x4a, 0xd8, 0xd3, 0x14,
+  0x68, 0x19, 0x06, 0xb7, 0x55, 0x76, 0x4c, 0xee, 0x1e, 0x12, 0x1c, 0x1f, 0x0e, 0x09, 0xd4, 0x47,
+  0xc6, 0x89, 0x0b, 0x5a, 0x9a, 0xb1, 0xa8, 0xc6, 0x1e, 0x23, 0x83, 0xd1, 0xed, 0x91, 0x4d, 0x3c,
+  0x28, 0xab, 0x40, 0x48, 0x02, 0x93, 0x41, 0xe8, 0x12, 0xe9, 0xf1, 0x88, 0x2c, 0x91, 0x8a, 0x4c,
+  0x43, 0x31, 0x87, 0x67, 0x46, 0x7a, 0xf7, 0x77, 0x4d, 0xfb, 0x8c, 0xac, 0x99, 0xac, 0x24, 0x4c,
+  0xc4, 0xa8, 0xd5, 0x6a, 0x06, 0x9a, 0xe2, 0x0a, 0x27, 0x9e, 0x43, 0x4c, 0xea, 0x50, 0x21, 0x03,
+  0x4c, 0x4a, 0x20, 0x5f, 0xaf, 0xdf, 0xba, 0x60, 0x46, 0xb5, 0xce, 0x71, 0xa0, 0xb8, 0x1c, 0x5f,
+  0x0d, 0x01, 0x80, 0xb8, 0xb6, 0x4a, 0x3c, 0x98, 0x95, 0x0a, 0xc2, 0xf2, 0x7e, 0x38, 0x79, 0x41,
+  0x8c, 0xde, 0x8c, 0x61, 0x19, 0xa0, 0x07, 0x3a, 0x6a, 0xc3, 0x8f, 0x3e, 0x24, 0x08, 0x72, 0x83,
+  0x66, 0xe2, 0x81, 0xf0, 0xe9, 0x84, 0xf9, 0xea, 0x69, 0xca, 0x43, 0x3c, 0x69, 0x50, 0xcc, 0x95,
+  0xdd, 0x2a, 0x1d, 0x85, 0x4c, 0x37, 0x4c, 0x03, 0x0f, 0x34, 0x6a, 0x2b, 0x84, 0xeb, 0x60, 0xc5,
+  0x39, 0x29, 0x4c, 0xd9, 0xd8, 0x73, 0x20, 0x4f, 0xd1, 0x35, 0x9d, 0x63, 0x09, 0x1b, 0x54, 0xed,
+  0x3e, 0x15, 0x0b, 0x28, 0x45, 0x78, 0xbc, 0x16, 0x2e, 0x94, 0xf3, 0x62, 0xc1, 0x02, 0xb7, 0xef,
+  0x71, 0xdf, 0xd5, 0xdc, 0x52, 0x89, 0x45, 0x4f, 0x39, 0xb0, 0x5e, 0x9b, 0x2a, 0x79, 0x9f, 0x3f,
+  0x2b, 0x9f, 0x3a, 0xc4, 0xc2, 0x44, 0xea, 0x86, 0x69, 0x91, 0x35, 0xcc, 0x40, 0x10, 0x55, 0xe1,
+  0x86, 0x56, 0x74, 0x7b, 0x85, 0x0d, 0xf0, 0x06, 0xd9, 0x49, 0x03, 0x67, 0x5c, 0xab, 0x5a, 0x97,
+  0xe2, 0x0d, 0x7f, 0x60, 0xae, 0xd9, 0xac, 0xa2, 0x9f, 0x24, 0x52, 0x34, 0xf0, 0x3f, 0xaf, 0x2d,
+  0x7c, 0x69, 0xf1, 0x22, 0x53, 0xd5, 0x44, 0x56, 0x50, 0x49, 0x81, 0x9c, 0xeb, 0x25, 0x2a, 0xe3,
+  0x30, 0x48, 0x2f, 0x9e, 0xc7, 0xec, 0x31, 0x95, 0x43, 0x55, 0xa8, 0x68, 0x24, 0xc3, 0xfc, 0x0c,
+  0x60, 0x29, 0x48, 0x0f, 0xcb, 0x5a, 0xf8, 0xee, 0x88, 0xa9, 0xa2, 0x32, 0x70, 0x52, 0x0e, 0x20,
+  0x6b, 0xe3, 0xcb, 0xbb, 0xc1, 0xe8, 0xf2, 0x66, 0x78, 0xf1, 0xeb, 0x7d, 0x6f, 0xf8, 0x6e, 0x00,
+  0x7b, 0xcd, 0xd3, 0xb3, 0x52, 0xb9, 0x8f, 0x33, 0x70, 0x7e, 0x72, 0x4c, 0x9d, 0xaf, 0x0e, 0x37,
+  0x23, 0xf5, 0x59, 0x5f, 0xcc, 0x31, 0xf4, 0xa6, 0x31, 0xbc, 0x79, 0x6f, 0x54, 0xab, 0x68, 0xb2,
+  0x55, 0x45, 0x71, 0x53, 0x5d, 0x0e, 0x70, 0x0c, 0x4d, 0x73, 0x5f, 0xde, 0xb6, 0x67, 0x52, 0xad,
+  0xa6, 0xeb, 0x11, 0x4c, 0xc9, 0xcc, 0xb4, 0x0e, 0x6b, 0xcd, 0x2a, 0xf0, 0x76, 0xcf, 0xcb, 0x46,
+  0x83, 0x96, 0x6f, 0x21, 0x56, 0x43, 0x52, 0x5d, 0xcd, 0xf6, 0x18, 0x8a, 0x90, 0xb9, 0x4f, 0x54,
+  0xd4, 0xce, 0xd1, 0x7a, 0x0f, 0x47, 0x5e, 0x12, 0xdf, 0x61, 0x0d, 0xbe, 0xb8, 0x7c, 0xb7, 0x39,
+  0x29, 0xc9, 0xe3, 0x7f, 0xd1, 0xa2, 0xcd, 0xd2, 0xc2, 0x8b, 0x96, 0x26, 0x75, 0x5d, 0x74, 0x71,
+  0x8a, 0x95, 0xad, 0x77, 0xe8, 0x0b, 0xb8, 0x3d, 0xea, 0x81, 0x58, 0x61, 0x3d, 0x97, 0x6f, 0xe8,
+  0x9c, 0x4e, 0xdf, 0x48, 0x3b, 0x1f, 0x55, 0x74, 0x29, 0x53, 0x72, 0x27, 0x46, 0x3c, 0x50, 0xbd,
+  0xb0, 0xa0, 0x24, 0xb5, 0x62, 0x1a, 0xd0, 0x0a, 0x1f, 0xdf, 0xc4, 0xb8, 0x76, 0xde, 0xd0, 0x4c,
+  0x7c, 0x2d, 0xfc, 0xc0, 0x3f, 0x26, 0xd7, 0xc4, 0x8f, 0x04, 0xde, 0xfa, 0x5b, 0x44, 0x5b, 0x7e,
+  0x91, 0xb0, 0xab, 0xbe, 0x93, 0x77, 0x89, 0xed, 0x08, 0x1f, 0x2a, 0xcc, 0x52, 0xb5, 0x0d, 0xd3,
+  0xc2, 0x6e, 0x59, 0x92, 0xde, 0x78, 0x7f, 0x4a, 0xa4, 0x79, 0x22, 0xdd, 0xdc, 0x21, 0x9d, 0xbf,
+  0x18, 0x25, 0x92, 0x91, 0x70, 0x12, 0x59, 0xbb, 0x24, 0xbb, 0xf9, 0x66, 0x91, 0x08, 0xd3, 0xf8,
+  0xe1, 0x83, 0xf5, 0x31, 0x91, 0x3f, 0x7e, 0x42, 0xde, 0xd6, 0xe4, 0x9b, 0xa9, 0xfc, 0xc9, 0x13,
+  0xf2, 0x47, 0x9a, 0xbc, 0x9d, 0xca, 0xbf, 0x2c, 0xc9, 0x6b, 0xa3, 0xfb, 0x61, 0x76, 0xf3, 0x21,
+  0x46, 0x82, 0x45, 0xd5, 0x04, 0x72, 0x5a, 0x82, 0x94, 0x47, 0xf2, 0x12, 0xae, 0x99, 0xe1, 0xce,
+  0x4a, 0xb8, 0x62, 0xea, 0x2e, 0x21, 0xec, 0x0c, 0xf1, 0xaa, 0x84, 0xd0, 0xa6, 0xe4, 0x12, 0xe4,
+  0x28, 0x83, 0x34, 0xad, 0x7d, 0x18, 0xbb, 0x8c, 0x39, 0xce, 0x31, 0xe5, 0x04, 0x6e, 0x8c, 0xbc,
+  0x25, 0xd4, 0x49, 0x8e, 0x52, 0xa9, 0x2c, 0x5d, 0xe1, 0x4a, 0xc6, 0x4b, 0xc8, 0xb4, 0x0b, 0x7a,
+  0xe3, 0x48, 0xe8, 0xb3, 0x64, 0x7e, 0x28, 0x1e, 0x3c, 0x29, 0x17, 0xe9, 0x34, 0xf8, 0xcb, 0xd5,
+  0xf0, 0x12, 0x9e, 0xee, 0xd8, 0xef, 0x20, 0x21, 0x11, 0xad, 0x76, 0x61, 0x58, 0x53, 0xc3, 0x58,
+  0x84, 0xc3, 0x98, 0xe3, 0xd1, 0x60, 0xc6, 0x76, 0xcd, 0x6d, 0x38, 0xc0, 0x94, 0xa6, 0xb6, 0x63,
+  0xf2, 0xfc, 0xb9, 0x1a, 0x6c, 0xea, 0x88, 0x8d, 0x23, 0x5c, 0xb3, 0x2d, 0x6b, 0xcf, 0xbc, 0x98,
+  0x12, 0x44, 0x0b, 0x68, 0x45, 0x6c, 0x0c, 0x73, 0x4b, 0x35, 0x1b, 0xe9, 0x52, 0x33, 0xa0, 0x7d,
+  0x9b, 0xc6, 0x4f, 0x83, 0x31, 0x84, 0xc6, 0x40, 0x45, 0x80, 0xc7, 0x28, 0x85, 0x31, 0xcb, 0x4d,
+  0x8d, 0xa0, 0xc3, 0x6f, 0xbb, 0xad, 0xff, 0x9c, 0xf2, 0x2f, 0xfb, 0x8d, 0xdd, 0x11, 0xe1, 0x80,
+  0xf0, 0x05, 0x75, 0xcd, 0x27, 0x5c, 0x6c, 0x20, 0x69, 0x61, 0xfa, 0x7e, 0x57, 0xe1, 0xa5, 0x28,
+  0x7d, 0xff, 0xe9, 0x34, 0xd2, 0xdf, 0x97, 0x1a, 0xc9, 0x0f, 0xcc, 0x7f, 0x01, 0x5d, 0x99, 0xf2,
+  0xa8, 0x68, 0x16, 0x00, 0x00,
+};
+const size_t MAIN_page_gz_len = 1781;
+const char MAIN_page_etag[] = "\"0f4d6a1c-6f5\"";
+
+// config.h: 6454 bytes, 4532 minified, 1192 gzipped
+const uint8_t CONFIG_page_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x58, 0x6d, 0x6f, 0x22, 0x37,
+  0x10, 0xfe, 0xbe, 0xbf, 0xc2, 0xb7, 0x51, 0x4f, 0x44, 0x0a, 0x90, 0x70, 0x89, 0x7a, 0x05, 0x82,
+  0x94, 0xe3, 0x68, 0x2f, 0x55, 0xc8, 0x45, 0x21, 0xba, 0xeb, 0x57, 0xb3, 0x1e, 0xc0, 0x8d, 0xb1,
+  0xb7, 0xb6, 0x17, 0x42, 0xab, 0xfc, 0xf7, 0x8e, 0xbd, 0x2f, 0xec, 0x12, 0x92, 0xc2, 0xb5, 0xd2,
+  0xa5, 0x5f, 0xd8, 0x78, 0xed, 0x79, 0xe6, 0x99, 0x99, 0xc7, 0x63, 0x6f, 0xba, 0x33, 0x3b, 0x17,
+  0xbd, 0xa0, 0x3b, 0x03, 0xca, 0xf0, 0x61, 0xec, 0x4a, 0x40, 0x2f, 0x38, 0x18, 0x53, 0x29, 0x41,
+  0x93, 0xbf, 0x82, 0x31, 0x8d, 0xee, 0xa7, 0x5a, 0x25, 0x92, 0xd5, 0x23, 0x25, 0x94, 0x6e, 0x93,
+  0x83, 0xd3, 0x93, 0x8b, 0xc1, 0x60, 0xd0, 0x09, 0xb2, 0xf1, 0x72, 0xc6, 0x2d, 0x74, 0x02, 0x0b,
+  0x0f, 0xb6, 0x4e, 0x05, 0x9f, 0xca, 0x36, 0x89, 0x40, 0x5a, 0xd0, 0x9d, 0x60, 0xa2, 0xa4, 0xad,
+  0x1b, 0xfe, 0x27, 0xb4, 0xc9, 0x8f, 0xc7, 0xf1, 0x43, 0x27, 0x88, 0x29, 0x63, 0x5c, 0x4e, 0xdb,
+  0xe4, 0xd4, 0x0f, 0xc7, 0x4a, 0x33, 0x40, 0x08, 0xa3, 0x04, 0x67, 0xa4, 0x15, 0x3f, 0x90, 0xb1,
+  0x40, 0x7f, 0xf9, 0x44, 0x5d, 0x53, 0xc6, 0x13, 0xd3, 0x26, 0x67, 0x6e, 0xf1, 0x9c, 0xea, 0x29,
+  0x97, 0xf5, 0xb1, 0xb2, 0x56, 0xcd, 0xdb, 0xe4, 0x27, 0x8f, 0xb0, 0xe4, 0xcc, 0xce, 0xda, 0xe4,
+  0xe4, 0xf8, 0xf8, 0x87, 0x4e, 0xf0, 0x18, 0x1c, 0x08, 0x6e, 0x6c, 0xfd, 0x04, 0x79, 0x33, 0x6e,
+  0x62, 0x41, 0x57, 0x6d, 0x32, 0x11, 0x80, 0xeb, 0xdc, 0x6f, 0x9d, 0x71, 0x0d, 0x91, 0xe5, 0xca,
+  0x31, 0x54, 0x22, 0x99, 0xcb, 0x4e, 0xe0, 0x09, 0xd7, 0x31, 0x80, 0xb9, 0x59, 0xd3, 0xce, 0x02,
+  0xcb, 0xb8, 0x64, 0x7e, 0xad, 0x8a, 0x9d, 0x1f, 0xe7, 0x74, 0x5b, 0xa8, 0xb9, 0xef, 0xd6, 0x53,
+  0xdf, 0xbf, 0x27, 0xc6, 0xf2, 0xc9, 0x0a, 0xf3, 0x87, 0x4b, 0xa5, 0x5d, 0xdb, 0xfc, 0xb7, 0xce,
+  0x25, 0xf8, 0xc0, 0xb3, 0xd4, 0x15, 0x16, 0x59, 0x72, 0xa7, 0x9a, 0xae, 0x8a, 0x74, 0xbd, 0x77,
+  0xd9, 0x4a, 0xa1, 0xd3, 0x44, 0x12, 0x9a, 0x58, 0xb5, 0xc6, 0x69, 0x3d, 0x8f, 0x93, 0xf1, 0xaa,
+  0xe4, 0x3d, 0x47, 0x3a, 0xab, 0x20, 0x8d, 0x13, 0x2c, 0x94, 0x4c, 0xb1, 0x9e, 0x17, 0xd1, 0x46,
+  0xa5, 0x5b, 0x3e, 0xc6, 0x6a, 0x0e, 0xf6, 0x53, 0xd1, 0xd9, 0x5a, 0x45, 0x39, 0xaf, 0x77, 0x67,
+  0x25, 0xa9, 0xbc, 0x3f, 0xf3, 0x46, 0x33, 0xe0, 0xd3, 0x19, 0xd6, 0xa2, 0xd5, 0xf2, 0x93, 0x79,
+  0xf9, 0xde, 0x7d, 0x17, 0xe9, 0x74, 0x9b, 0xd9, 0xbe, 0xeb, 0x36, 0xb3, 0x7d, 0x38, 0x56, 0x6c,
+  0xe5, 0x1e, 0x3e, 0x87, 0x84, 0xb3, 0xf3, 0x30, 0xdd, 0x91, 0x21, 0x51, 0x32, 0x12, 0x3c, 0xba,
+  0x3f, 0x0f, 0xa7, 0x60, 0x6f, 0x61, 0xae, 0x2c, 0xdc, 0xd0, 0x29, 0xd4, 0x0e, 0xc3, 0xde, 0xe0,
+  0xcb, 0xe5, 0x90, 0xf4, 0x95, 0x9c, 0xf0, 0x69, 0xa2, 0xa9, 0x23, 0xdb, 0x6d, 0xa6, 0x00, 0x88,
+  0xc4, 0xf8, 0xc2, 0xc3, 0xa4, 0x1b, 0x24, 0xdc, 0xc0, 0xce, 0x4a, 0x55, 0x45, 0xff, 0xca, 0x27,
+  0xbc, 0xaf, 0x81, 0xe5, 0xf8, 0x43, 0xc5, 0x50, 0xc6, 0xe4, 0x2b, 0xaf, 0xff, 0xcc, 0xc9, 0x45,
+  0x14, 0x81, 0x31, 0xe4, 0x46, 0x71, 0x69, 0x0d, 0x71, 0xcb, 0x30, 0x1a, 0x4e, 0x85, 0x29, 0xf9,
+  0xdc, 0xc9, 0xc3, 0x2d, 0xe0, 0xbe, 0x90, 0x98, 0x5c, 0xe7, 0xe2, 0x1a, 0xec, 0x52, 0xe9, 0x7b,
+  0x52, 0xbc, 0xdc, 0x07, 0xed, 0x16, 0x8c, 0xa5, 0xda, 0x8e, 0x40, 0x2f, 0x40, 0x3b, 0xb4, 0xfe,
+  0x2a, 0x12, 0x80, 0x58, 0x58, 0xcc, 0x12, 0x4e, 0x13, 0x53, 0x51, 0x49, 0x88, 0x13, 0x7c, 0xd8,
+  0x7b, 0xfa, 0xde, 0xc9, 0x21, 0x2c, 0xbd, 0xc1, 0xe7, 0x65, 0x7c, 0xc1, 0x98, 0xc6, 0xc0, 0xbf,
+  0x50, 0x91, 0x40, 0x48, 0x7c, 0xd9, 0xce, 0xc3, 0x4d, 0x85, 0xe6, 0xc2, 0xf3, 0x6a, 0x0e, 0x7b,
+  0x97, 0x37, 0x24, 0x33, 0x6b, 0x93, 0xae, 0x89, 0x69, 0x1a, 0x04, 0xaf, 0x62, 0xf5, 0xee, 0x90,
+  0x3e, 0x0a, 0x01, 0xa7, 0x9f, 0x70, 0xc1, 0x67, 0x3f, 0xd1, 0x1a, 0x33, 0xfc, 0xf1, 0x7a, 0xb4,
+  0x97, 0x6b, 0x34, 0x43, 0x2b, 0x82, 0x66, 0x65, 0xd7, 0xd1, 0x06, 0xd8, 0x3f, 0xf8, 0xc6, 0xaa,
+  0x0c, 0xa9, 0xb9, 0xdf, 0xcb, 0x31, 0xda, 0x10, 0x67, 0x54, 0x76, 0x2b, 0xcb, 0x38, 0xdb, 0x7c,
+  0xfe, 0x9b, 0xd2, 0x0c, 0x2f, 0xfa, 0x2f, 0x13, 0x44, 0x01, 0x5f, 0xf4, 0xc9, 0x79, 0x89, 0x4f,
+  0x61, 0x52, 0xe6, 0x42, 0x36, 0xc8, 0x98, 0x48, 0xf3, 0xd8, 0xf6, 0x82, 0x05, 0xd5, 0x24, 0x56,
+  0x42, 0xdc, 0xf1, 0x39, 0x1e, 0x8c, 0xe7, 0x44, 0x26, 0x42, 0x60, 0x73, 0x48, 0xa4, 0x6f, 0x0b,
+  0xc4, 0x4b, 0xef, 0x06, 0xe7, 0xb1, 0x31, 0xd5, 0x0e, 0xb1, 0x8b, 0xf0, 0x09, 0xa9, 0x95, 0xd6,
+  0xa7, 0x06, 0x6e, 0xa2, 0x0c, 0x62, 0xc0, 0x5e, 0xba, 0x26, 0xb0, 0xa0, 0xa2, 0x96, 0x43, 0x79,
+  0x6b, 0x94, 0x73, 0xa1, 0xb5, 0xda, 0x61, 0xc7, 0x8d, 0xf3, 0x6a, 0x65, 0xc3, 0x72, 0x51, 0xb2,
+  0x57, 0x79, 0x3c, 0x6e, 0xf8, 0x78, 0x84, 0xed, 0xf8, 0xf8, 0xb0, 0x43, 0x9a, 0x4d, 0x7c, 0xce,
+  0x47, 0x6e, 0x43, 0x31, 0x43, 0x92, 0x98, 0x51, 0x0b, 0x04, 0xdb, 0x03, 0x60, 0xdf, 0x79, 0xf4,
+  0x2c, 0xdf, 0xbc, 0x59, 0x72, 0xc9, 0xd4, 0xb2, 0x31, 0x58, 0xa0, 0x28, 0x46, 0x2a, 0xd1, 0x11,
+  0x38, 0x0e, 0x2e, 0x62, 0xe3, 0x47, 0x2e, 0x5c, 0x58, 0x92, 0xd2, 0x7c, 0x2d, 0x04, 0x37, 0x30,
+  0x21, 0xba, 0x4a, 0xd7, 0x34, 0xb0, 0x29, 0xfb, 0x05, 0x57, 0x58, 0x1d, 0xc0, 0x56, 0x55, 0x73,
+  0xf5, 0x76, 0xbb, 0x39, 0x3c, 0x22, 0x45, 0x6c, 0x05, 0x70, 0x36, 0x87, 0xc8, 0xbf, 0x8e, 0x3e,
+  0x5f, 0x37, 0x62, 0xaa, 0x0d, 0xd4, 0xa0, 0x81, 0xec, 0x28, 0x42, 0x32, 0x15, 0x25, 0x73, 0xc4,
+  0x6a, 0x60, 0x54, 0x03, 0x01, 0xee, 0xcf, 0x0f, 0xab, 0x4b, 0x56, 0xdb, 0xdc, 0x34, 0x87, 0x0d,
+  0xee, 0xba, 0xe2, 0xa7, 0xbb, 0xe1, 0x95, 0xe7, 0xe8, 0x31, 0x1b, 0x3c, 0x7e, 0x01, 0x61, 0x53,
+  0xfb, 0xdb, 0x21, 0x98, 0x34, 0x2f, 0x60, 0x54, 0x84, 0xbc, 0x1d, 0x60, 0x8e, 0xf3, 0x2f, 0x20,
+  0x14, 0xd2, 0x7b, 0xce, 0x3a, 0xf2, 0x25, 0x9c, 0x60, 0x43, 0x85, 0x75, 0x8a, 0x15, 0xae, 0xd4,
+  0xca, 0x09, 0xa7, 0x22, 0x16, 0x57, 0xc4, 0x6c, 0x85, 0xc6, 0xe3, 0x63, 0x35, 0xb2, 0xae, 0xc6,
+  0x28, 0xb9, 0x52, 0xc1, 0x1a, 0xfd, 0xab, 0xcf, 0xa3, 0xc1, 0x47, 0xb7, 0xbc, 0x2a, 0x55, 0x77,
+  0xfe, 0x3c, 0xe2, 0x0f, 0x01, 0x74, 0xb5, 0x75, 0xb6, 0xd0, 0x78, 0x55, 0x94, 0x59, 0x21, 0x1f,
+  0x66, 0xd6, 0xc6, 0x99, 0x40, 0x7e, 0x1b, 0x5e, 0x7d, 0xc2, 0xd1, 0x2d, 0xfc, 0x91, 0xe0, 0x86,
+  0x72, 0xd6, 0x7e, 0x16, 0x79, 0x7b, 0x5e, 0xc6, 0xf1, 0x8a, 0x66, 0x54, 0x4e, 0x61, 0x5b, 0x08,
+  0x76, 0xc6, 0xcd, 0x46, 0x00, 0xa7, 0xe4, 0xed, 0x5b, 0xe2, 0xdf, 0x3b, 0xdb, 0xc4, 0xb8, 0x77,
+  0x2d, 0x94, 0xb5, 0x3b, 0xa5, 0xbf, 0x45, 0x22, 0x41, 0xe6, 0xc3, 0xc4, 0x4a, 0x1a, 0xb8, 0xc3,
+  0xc3, 0x38, 0x0b, 0x3f, 0xe3, 0x19, 0x83, 0xac, 0x85, 0xbf, 0x0c, 0xee, 0x50, 0xb2, 0xa1, 0x63,
+  0xb2, 0xd1, 0xef, 0x8f, 0x88, 0xd5, 0x09, 0x14, 0x61, 0x19, 0x90, 0xec, 0x69, 0x8a, 0xd6, 0xfb,
+  0xf4, 0xb5, 0x66, 0xe8, 0xc5, 0x2d, 0xb0, 0x6f, 0x8a, 0x0a, 0x94, 0x9d, 0x92, 0x53, 0xed, 0x5a,
+  0xaf, 0x35, 0x41, 0xcf, 0xef, 0xef, 0x7d, 0xb3, 0x53, 0x39, 0x3a, 0x77, 0xca, 0xd0, 0xba, 0x89,
+  0xbf, 0xd6, 0xec, 0x6c, 0xef, 0x5d, 0xfb, 0x66, 0xa6, 0x40, 0xd9, 0x29, 0x2b, 0x1b, 0x77, 0xbb,
+  0x7d, 0x52, 0xb3, 0xe9, 0xb8, 0x02, 0xb5, 0xab, 0xf7, 0xf5, 0x3d, 0xfb, 0x3b, 0x57, 0x45, 0xa8,
+  0xc8, 0x5f, 0xed, 0xd1, 0x42, 0x28, 0xca, 0x8a, 0xfe, 0xbd, 0x25, 0xd8, 0x66, 0x1a, 0x6d, 0x4e,
+  0x7d, 0xb7, 0x50, 0xab, 0x97, 0xfe, 0xff, 0x59, 0xb0, 0x65, 0xf2, 0xbb, 0x87, 0x5b, 0xfa, 0x02,
+  0x41, 0x9f, 0xf8, 0x37, 0x7e, 0x48, 0x42, 0x43, 0xa8, 0x69, 0x2d, 0x2c, 0xa6, 0xc8, 0x87, 0xf4,
+  0xeb, 0xe3, 0xc6, 0x1d, 0x06, 0xc0, 0xdc, 0xb5, 0xe7, 0x9b, 0x05, 0x58, 0xf1, 0xf9, 0x3c, 0x4d,
+  0xbc, 0x8f, 0x66, 0x57, 0x4f, 0xfc, 0x78, 0x49, 0x3f, 0x07, 0x9b, 0xe9, 0x3f, 0x6b, 0xfe, 0x06,
+  0x74, 0xd2, 0x89, 0x6a, 0xb4, 0x11, 0x00, 0x00,
+};
+const size_t CONFIG_page_gz_len = 1192;
+const char CONFIG_page_etag[] = "\"a1aefa30-4a8\"";
+
+// credentials.h: 5552 bytes, 3401 minified, 1109 gzipped
+const uint8_t CREDENTIAL_page_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x57, 0x5b, 0x4f, 0xe4, 0x36,
+  0x14, 0x7e, 0xcf, 0xaf, 0x38, 0x0a, 0x2a, 0xca, 0x88, 0x9d, 0x3b, 0xa8, 0xdb, 0xb9, 0x55, 0x5b,
+  0x96, 0xb6, 0x54, 0x2d, 0x45, 0xb0, 0x15, 0x95, 0x10, 0x0f, 0x9e, 0xd8, 0x93, 0x78, 0xc9, 0xd8,
+  0xa9, 0xed, 0x00, 0x53, 0x76, 0xfe, 0x7b, 0x8f, 0x1d, 0x87, 0x09, 0x03, 0x03, 0x4c, 0xab, 0x6a,
+  0x5f, 0x92, 0xd8, 0x3e, 0x97, 0xcf, 0xdf, 0xf9, 0x7c, 0x92, 0x8c, 0x52, 0x33, 0xcf, 0x26, 0xc1,
+  0x28, 0x65, 0x84, 0xe2, 0x4d, 0x9b, 0x45, 0xc6, 0x26, 0xc1, 0xce, 0x94, 0x08, 0xc1, 0x14, 0xdc,
+  0x07, 0x53, 0x12, 0x5f, 0x27, 0x4a, 0x16, 0x82, 0x36, 0x63, 0x99, 0x49, 0x35, 0x80, 0x9d, 0xfd,
+  0xee, 0x87, 0xa3, 0xa3, 0xa3, 0x61, 0xe0, 0xc7, 0xb7, 0x29, 0x37, 0x6c, 0x18, 0x18, 0x76, 0x67,
+  0x9a, 0x24, 0xe3, 0x89, 0x18, 0x40, 0xcc, 0x84, 0x61, 0x6a, 0x18, 0xcc, 0xa4, 0x30, 0x4d, 0xcd,
+  0xff, 0x66, 0x03, 0xf8, 0xb6, 0x93, 0xdf, 0x0d, 0x83, 0x9c, 0x50, 0xca, 0x45, 0x32, 0x80, 0x7d,
+  0x37, 0x9c, 0x4a, 0x45, 0x19, 0x86, 0xd0, 0x32, 0xe3, 0x14, 0x7a, 0xf9, 0x1d, 0x4c, 0x33, 0xcc,
+  0x57, 0x2d, 0x34, 0x15, 0xa1, 0xbc, 0xd0, 0x03, 0x38, 0xb0, 0xc6, 0x73, 0xa2, 0x12, 0x2e, 0x9a,
+  0x53, 0x69, 0x8c, 0x9c, 0x0f, 0xe0, 0x3b, 0x17, 0xe1, 0x96, 0x53, 0x93, 0x0e, 0xa0, 0xdb, 0xe9,
+  0x7c, 0x33, 0x0c, 0x96, 0xc1, 0x4e, 0xc6, 0xb5, 0x69, 0x76, 0x11, 0x37, 0xe5, 0x3a, 0xcf, 0xc8,
+  0x62, 0x00, 0xb3, 0x8c, 0xa1, 0x9d, 0xbd, 0x36, 0x29, 0x57, 0x2c, 0x36, 0x5c, 0x5a, 0x84, 0x32,
+  0x2b, 0xe6, 0x62, 0x18, 0x38, 0xc0, 0x4d, 0xdc, 0xc0, 0x5c, 0xaf, 0x60, 0xfb, 0x8d, 0x79, 0x2c,
+  0x3e, 0xaf, 0x91, 0xb9, 0xcd, 0x63, 0x93, 0x56, 0x79, 0x7a, 0x4f, 0xf3, 0x7c, 0x2e, 0xb4, 0xe1,
+  0xb3, 0x05, 0x72, 0x85, 0xa1, 0x84, 0x59, 0xc5, 0xfc, 0xf7, 0x89, 0x04, 0x73, 0x1b, 0xf2, 0x94,
+  0x3c, 0xac, 0x7a, 0xd2, 0x12, 0x45, 0x16, 0x0f, 0x34, 0xbc, 0xb7, 0x2c, 0x94, 0x61, 0x4a, 0x82,
+  0x80, 0x14, 0x46, 0xae, 0xe2, 0xf4, 0x36, 0xc7, 0xf1, 0x18, 0x5e, 0x0f, 0x34, 0x2d, 0x90, 0x7f,
+  0xf1, 0xb2, 0x32, 0xd6, 0xca, 0xd7, 0x73, 0x9b, 0x79, 0xbc, 0xd9, 0xed, 0xa4, 0x71, 0xb0, 0x92,
+  0x46, 0x85, 0xaa, 0x34, 0x7b, 0x4e, 0x75, 0x0f, 0x25, 0x99, 0x66, 0xb2, 0xee, 0xd1, 0xa9, 0xb3,
+  0x81, 0xe5, 0xeb, 0xff, 0xef, 0x32, 0x31, 0x64, 0x9a, 0x31, 0xcc, 0xf2, 0x14, 0x01, 0x17, 0x79,
+  0x61, 0x2e, 0xcd, 0x22, 0x67, 0xe3, 0xd0, 0xee, 0x21, 0xbc, 0x42, 0x33, 0x4f, 0x7e, 0xbf, 0xe7,
+  0xf4, 0x9e, 0x32, 0x9e, 0xa4, 0xc6, 0x69, 0xdb, 0x0e, 0x6b, 0x84, 0xf5, 0x0f, 0x1e, 0x11, 0xd6,
+  0xf5, 0x84, 0xdd, 0xd9, 0x65, 0x37, 0xe3, 0xf9, 0xc7, 0xa9, 0x97, 0xe6, 0x37, 0x10, 0xbc, 0xf9,
+  0xec, 0x55, 0xa4, 0xfb, 0xad, 0x66, 0x6c, 0x86, 0xf0, 0x4a, 0xb0, 0xcb, 0x60, 0xd4, 0xf6, 0xbd,
+  0x63, 0xd4, 0xf6, 0xbd, 0x64, 0x2a, 0xe9, 0x02, 0xa4, 0xc8, 0x24, 0xa1, 0xe3, 0x30, 0x61, 0xe6,
+  0x84, 0x99, 0x5b, 0xa9, 0xae, 0x0f, 0x15, 0xa3, 0x3a, 0x6a, 0x84, 0xd6, 0xa2, 0xd4, 0x12, 0xc7,
+  0xf5, 0xb2, 0xe1, 0x84, 0x68, 0x1f, 0x67, 0x3c, 0xbe, 0x76, 0x0e, 0x87, 0x52, 0xcc, 0x78, 0x72,
+  0x4a, 0x12, 0x66, 0xcd, 0x2f, 0x78, 0xf3, 0x47, 0x0e, 0x1f, 0xe2, 0x98, 0x69, 0x0d, 0xa7, 0x92,
+  0x0b, 0xa3, 0xc1, 0xc6, 0xc2, 0x6a, 0x70, 0x92, 0xe9, 0x51, 0xbb, 0x8c, 0x86, 0x61, 0x1d, 0xed,
+  0xf6, 0xae, 0xec, 0x25, 0x05, 0x07, 0x6c, 0x1c, 0xd6, 0x18, 0x74, 0xfb, 0x08, 0x27, 0xa7, 0x8a,
+  0x4b, 0xc5, 0xcd, 0x62, 0xd4, 0x36, 0xe9, 0x2b, 0xa6, 0x1e, 0x3c, 0x9c, 0x90, 0x39, 0xdb, 0xc2,
+  0xfc, 0x94, 0x68, 0x8d, 0x0f, 0xd4, 0xbb, 0xb4, 0x4b, 0x48, 0xee, 0x42, 0x9f, 0xf1, 0x7e, 0x5f,
+  0x7a, 0x77, 0x5b, 0x68, 0x49, 0x9d, 0xd1, 0x64, 0xe4, 0xa4, 0x02, 0x35, 0xa9, 0x38, 0xbe, 0x44,
+  0x99, 0xc0, 0xc2, 0xe9, 0x86, 0x93, 0xb7, 0x9a, 0x57, 0x70, 0x56, 0x2e, 0x6f, 0x44, 0xd4, 0xdb,
+  0x0a, 0x51, 0x6f, 0x7b, 0x44, 0xbd, 0x6d, 0x11, 0xf5, 0xb7, 0x42, 0xd4, 0xdf, 0x1e, 0x51, 0x7f,
+  0x0d, 0x51, 0xbb, 0x92, 0x55, 0x5d, 0xb5, 0xee, 0xb1, 0xa6, 0xda, 0x72, 0xa2, 0xa6, 0x74, 0xaf,
+  0x4e, 0x2b, 0xe0, 0x73, 0x72, 0xc3, 0x36, 0x28, 0x56, 0xc7, 0x8a, 0xe7, 0x66, 0x12, 0x68, 0x66,
+  0x8e, 0x6d, 0x73, 0xb9, 0x21, 0x59, 0x34, 0x2b, 0x84, 0xeb, 0x42, 0x51, 0x03, 0x5b, 0xc3, 0xf2,
+  0x1d, 0x1c, 0x74, 0x3a, 0x8d, 0x21, 0xb4, 0xdb, 0xbd, 0x4e, 0xa7, 0x33, 0x3f, 0x67, 0xf8, 0x86,
+  0xa1, 0x1a, 0x8a, 0x9c, 0x12, 0xc3, 0x40, 0xe1, 0x25, 0xa8, 0x1c, 0x60, 0xed, 0xe8, 0xa0, 0xfb,
+  0x0d, 0x51, 0x70, 0x97, 0x1a, 0x93, 0xc3, 0x18, 0x04, 0xbb, 0x85, 0x3f, 0x7f, 0xfb, 0xf5, 0x67,
+  0x1c, 0x9d, 0xb1, 0xbf, 0x0a, 0xa6, 0x4d, 0xd4, 0x18, 0x06, 0x6e, 0xb5, 0x25, 0x85, 0xc2, 0xb3,
+  0xbb, 0xd0, 0x06, 0xe3, 0xc5, 0x29, 0x11, 0x09, 0x43, 0x87, 0x47, 0x40, 0xf8, 0x0c, 0x22, 0x93,
+  0x72, 0xdd, 0x72, 0x86, 0xe7, 0xd6, 0x10, 0xc6, 0x63, 0xd8, 0x87, 0xdd, 0x5d, 0x70, 0xf3, 0xd6,
+  0xb7, 0xd0, 0x76, 0x0e, 0x81, 0x5a, 0x0f, 0x6c, 0xc2, 0xc4, 0xba, 0xa3, 0x87, 0x6d, 0x05, 0x36,
+  0xd9, 0x32, 0x58, 0x3e, 0x64, 0xcc, 0x99, 0x88, 0xc2, 0x9f, 0x8e, 0x3e, 0x85, 0xef, 0x20, 0x6c,
+  0xdb, 0xa0, 0x2b, 0xe8, 0x38, 0x65, 0x54, 0xc1, 0x1e, 0xd0, 0x69, 0x26, 0xbc, 0x7b, 0x7d, 0xab,
+  0x8f, 0xdb, 0xca, 0xd7, 0xdd, 0xab, 0xcd, 0x1d, 0x5b, 0x20, 0x18, 0xea, 0x97, 0xf3, 0xdf, 0x4f,
+  0x5a, 0x39, 0x51, 0x9a, 0x55, 0x41, 0x74, 0x2e, 0x85, 0x66, 0x9f, 0x50, 0x70, 0x0d, 0xfb, 0xf6,
+  0x10, 0xd8, 0x7a, 0x59, 0x2b, 0x93, 0x49, 0x14, 0x7e, 0x24, 0x86, 0xc0, 0x19, 0x33, 0x8a, 0x33,
+  0x2c, 0xfd, 0x00, 0xc2, 0x35, 0x03, 0x17, 0xb3, 0x61, 0x5f, 0x02, 0x0a, 0x22, 0x9b, 0x84, 0x63,
+  0x82, 0xce, 0x10, 0x6f, 0x23, 0xe8, 0xe3, 0x6d, 0x6f, 0xaf, 0xca, 0xee, 0x45, 0x8c, 0xcb, 0xce,
+  0xa7, 0xe5, 0xc7, 0xfa, 0x92, 0x5f, 0xc1, 0x97, 0x2f, 0x70, 0xaf, 0x35, 0xa7, 0x18, 0x1f, 0xa9,
+  0xcd, 0xbd, 0xce, 0xed, 0x08, 0xcb, 0x41, 0x65, 0x5c, 0xcc, 0x51, 0x99, 0x2d, 0xa4, 0xf4, 0x28,
+  0x63, 0xf6, 0xf1, 0x87, 0xc5, 0x31, 0x8d, 0xea, 0xa7, 0x28, 0x84, 0x3d, 0x88, 0x38, 0x5e, 0xba,
+  0x8d, 0x46, 0x0b, 0x81, 0x16, 0xcc, 0x71, 0xec, 0xd6, 0x5b, 0x36, 0xf2, 0xeb, 0x61, 0xaa, 0xd3,
+  0xf5, 0x62, 0xa8, 0x0a, 0x9a, 0x53, 0xca, 0x06, 0xad, 0xd8, 0x9a, 0xd4, 0x4b, 0xff, 0x06, 0xb1,
+  0x68, 0x3c, 0x80, 0x17, 0x7c, 0xc6, 0xbd, 0x54, 0xbe, 0xf2, 0xb9, 0x88, 0xad, 0xce, 0xd5, 0x3c,
+  0x0a, 0x2f, 0x38, 0xbe, 0xd7, 0x6a, 0x7d, 0x01, 0x6c, 0xa3, 0xa0, 0x61, 0x75, 0x4e, 0x2c, 0x46,
+  0x6a, 0xf5, 0x31, 0x86, 0xcb, 0xab, 0x35, 0x09, 0x74, 0x9d, 0x04, 0xc6, 0x35, 0x0d, 0x58, 0xcb,
+  0x56, 0x5e, 0xe8, 0x14, 0x19, 0xb7, 0x1c, 0x5b, 0x8a, 0xc3, 0xb1, 0x7d, 0x62, 0x22, 0x96, 0x94,
+  0xfd, 0x71, 0x76, 0x7c, 0x28, 0xe7, 0x28, 0x44, 0x4c, 0x16, 0xbd, 0xb5, 0xe6, 0xdc, 0x97, 0xa8,
+  0x81, 0x98, 0x6a, 0x09, 0xf2, 0xff, 0x9c, 0xa0, 0xae, 0x86, 0x7a, 0x92, 0xe5, 0x73, 0x15, 0x7f,
+  0x54, 0xbe, 0xef, 0xad, 0x8b, 0xc3, 0xf2, 0x19, 0x3f, 0x05, 0xa2, 0x70, 0x37, 0x6c, 0xbc, 0x2e,
+  0x80, 0xcd, 0xdd, 0xf9, 0x3e, 0x58, 0x13, 0xc7, 0x30, 0x78, 0xd2, 0x5a, 0xfc, 0x57, 0x8e, 0x6f,
+  0xd5, 0xd8, 0xbd, 0xf1, 0xfb, 0xc6, 0x7d, 0xee, 0xb8, 0x3f, 0xa8, 0x7f, 0x00, 0x44, 0xca, 0x6b,
+  0x0a, 0x49, 0x0d, 0x00, 0x00,
+};
+const size_t CREDENTIAL_page_gz_len = 1109;
+const char CREDENTIAL_page_etag[] = "\"0204e2e5-455\"";
+
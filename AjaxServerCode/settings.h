@@ -0,0 +1,154 @@
+// ===Settings record kept in EEPROM===
+//
+// Everything the ESP32 has to remember across power cycles lives in one
+// fixed layout record at EEPROM address 0:
+//
+//   magic, version, length | Wi-Fi slots | static IP | poll rates | Wi-Fi cache | CRC
+//
+// The CRC is the same CRC-16/CCITT as the AVR128 link (avr_link.h) over
+// everything before it. setup() reads the record once into RAM and
+// everything works from that copy; settingsSave() only writes the EEPROM when
+// the copy differs from what is stored.
+//
+// Fields are only ever added at the end, before the CRC. A record with an
+// older version is still read (it is shorter, see length) and the new fields
+// get their defaults. Before the record existed the EEPROM held the Wi-Fi
+// credentials as a "name1,password1,..." string at address 0;
+// settingsLoad() converts that once.
+
+#define SETTINGS_MAGIC          0x574D  // "WM"
+#define SETTINGS_VERSION        1
+#define SETTINGS_ADDR           0
+#define SETTINGS_EEPROM_SIZE    512
+#define SETTINGS_LEGACY_SIZE    250     // EEPROM the credential string had
+#define WIFI_SLOTS              3
+
+struct WifiSlot {
+  char ssid[33];
+  char password[65];
+};
+
+// Last network that worked, for the fast path in wifiAttempt()
+struct WifiCache {
+  uint8_t valid;
+  char ssid[33];
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint32_t ip, gateway, mask, dns;
+};
+
+struct Settings {
+  uint16_t magic;
+  uint8_t version;
+  uint16_t length;                 // sizeof(Settings) when it was written
+  WifiSlot wifi[WIFI_SLOTS];
+  // Station side address, DHCP unless useStaticIp
+  uint8_t useStaticIp;
+  uint32_t staticIp, staticGateway, staticMask, staticDns;
+  // Poll rates, ms
+  uint16_t telemetryRefreshMs;     // AVR128 snapshot requests
+  uint16_t pushIntervalMs;         // Fastest SSE telemetry push
+  uint16_t historyIntervalMs;      // History and trip log samples
+  WifiCache wifiCache;
+  uint16_t crc;                    // Always last
+} __attribute__((packed));
+
+void settingsDefaults(Settings &s) {
+  memset(&s, 0, sizeof(s));
+  s.magic = SETTINGS_MAGIC;
+  s.version = SETTINGS_VERSION;
+  s.length = sizeof(Settings);
+  s.telemetryRefreshMs = 500;
+  s.pushIntervalMs = 500;
+  s.historyIntervalMs = 1000;
+}
+
+uint16_t settingsCrc(const uint8_t *p, size_t n) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < n; i++) {
+    crc = avrCrc16Update(crc, p[i]);
+  }
+  return crc;
+}
+
+// Rebuild the slots from the old comma joined credential string
+void settingsFromLegacy(Settings &s) {
+  char legacy[SETTINGS_LEGACY_SIZE];
+  size_t n = 0;
+  int field = 0;
+  size_t pos = 0;
+
+  while (n < SETTINGS_LEGACY_SIZE - 1) {
+    char c = EEPROM.read(SETTINGS_ADDR + n);
+    if (c == '\0') {
+      break;
+    }
+    if (!isprint((unsigned char)c)) {
+      return; // Blank or scrambled EEPROM, nothing to convert
+    }
+    legacy[n++] = c;
+  }
+  legacy[n] = '\0';
+
+  for (size_t i = 0; i <= n && field < 2 * WIFI_SLOTS; i++) {
+    if (legacy[i] != ',' && legacy[i] != '\0') {
+      continue;
+    }
+    // Empty fields are kept, an open network's blank password is one
+    char *out = (field % 2 == 0) ? s.wifi[field / 2].ssid : s.wifi[field / 2].password;
+    size_t size = (field % 2 == 0) ? sizeof(s.wifi[0].ssid) : sizeof(s.wifi[0].password);
+    size_t len = min(i - pos, size - 1);
+    memcpy(out, legacy + pos, len);
+    out[len] = '\0';
+    field++;
+    pos = i + 1;
+  }
+}
+
+// Read the record, falling back to the legacy layout and then to the defaults.
+// Returns false when the EEPROM did not hold a current record, so the caller
+// knows to save one.
+bool settingsLoad(Settings &s) {
+  uint8_t raw[sizeof(Settings)];
+  uint16_t length;
+
+  for (size_t i = 0; i < sizeof(raw); i++) {
+    raw[i] = EEPROM.read(SETTINGS_ADDR + i);
+  }
+  memcpy(&length, raw + offsetof(Settings, length), sizeof(length));
+  settingsDefaults(s);
+
+  if (raw[0] == (SETTINGS_MAGIC & 0xFF) && raw[1] == (SETTINGS_MAGIC >> 8) &&
+      length >= offsetof(Settings, wifi) + 2 && length <= sizeof(Settings)) {
+    uint16_t crc = raw[length - 2] | (uint16_t)raw[length - 1] << 8;
+    if (crc == settingsCrc(raw, length - 2)) {
+      // Older records are shorter, what they lack keeps its default
+      memcpy(&s, raw, length - 2);
+      bool current = s.version == SETTINGS_VERSION;
+      s.version = SETTINGS_VERSION;
+      s.length = sizeof(Settings);
+      return current;
+    }
+  }
+
+  settingsFromLegacy(s);
+  return false;
+}
+
+// Write the record if it differs from the EEPROM, true if it had to
+bool settingsSave(Settings &s) {
+  bool changed = false;
+
+  s.crc = settingsCrc((const uint8_t *)&s, offsetof(Settings, crc));
+  const uint8_t *p = (const uint8_t *)&s;
+  for (size_t i = 0; i < sizeof(Settings); i++) {
+    if (EEPROM.read(SETTINGS_ADDR + i) != p[i]) {
+      EEPROM.write(SETTINGS_ADDR + i, p[i]);
+      changed = true;
+    }
+  }
+  if (changed) {
+    EEPROM.commit();
+  }
+  return changed;
+}
@@ -0,0 +1,117 @@
+// ===Telemetry snapshot kept in RAM by the background AVR128 poller===
+//
+// Every value the AVR128 reports over the remote link gets one slot.
+// The poller in AjaxServerTest.ino refreshes the slots in the background and
+// the HTTP handlers only ever read them, so a web request never waits on the
+// UART.
+
+// One slot per value in the AVR128 snapshot frame (see avr_link.h)
+enum TelemetryField {
+  TELEM_PACK_VOLTAGE,  // pack_voltage_array
+  TELEM_PACK_CURRENT,  // pack_current_array
+  TELEM_PACK_SOC,      // pack_soc_array
+  TELEM_PACK_POWER,    // pack_kwh_array
+  TELEM_AUX5,          // Aux-5V digits
+  TELEM_AUX12,         // Aux-12V digits
+  TELEM_ACCY133,       // Accy 13.3V battery digits
+  TELEM_MOTOR,         // scaled_temps_array[5]
+  TELEM_CONTROLLER,    // scaled_temps_array[4]
+  TELEM_DCDC,          // scaled_temps_array[3]
+  TELEM_BBOX1,         // scaled_temps_array[2]
+  TELEM_BBOX2,         // scaled_temps_array[1]
+  TELEM_AMBIENT,       // scaled_temps_array[0]
+  TELEM_COUNT
+};
+
+// How to turn a slot's fixed point value back into text
+struct TelemetryFormat {
+  uint8_t decimals;   // Value is scaled by 10^decimals
+  const char *unit;   // Appended after the number
+  bool showPlus;      // Print a '+' in front of positive values
+};
+
+const TelemetryFormat TELEMETRY_FORMATS[TELEM_COUNT] = {
+  {2, "V", false},   // 176.54V
+  {1, "A", true},    // +12.3A
+  {1, "%", false},   // 98.7%
+  {1, "WH", false},  // -4321.1WH
+  {2, "", false},    // Aux voltages
+  {2, "", false},
+  {2, "", false},
+  {1, "", false},    // Temperatures in tenths of a degree
+  {1, "", false},
+  {1, "", false},
+  {1, "", false},
+  {1, "", false},
+  {1, "", false}
+};
+
+// Last value received for one slot and when it arrived
+struct TelemetryValue {
+  long value;               // Fixed point, see TELEMETRY_FORMATS
+  unsigned long updatedAt;  // millis() when the value arrived
+  bool valid;               // False until the first value arrives
+};
+
+// Everything the poller keeps; handlers work on a copy (see readSnapshot())
+struct TelemetrySnapshot {
+  TelemetryValue values[TELEM_COUNT];
+  uint8_t flags;            // AVR_FLAG_* bits
+  bool flagsValid;
+  unsigned long version;    // Bumped whenever a value changes
+};
+
+// ===Seqlock between the acquisition task and everyone else===
+//
+// One task writes, any number of tasks read, nobody takes a lock. The writer
+// makes seq odd, copies its new snapshot in and makes seq even again. A
+// reader copies the snapshot out and keeps the copy only if seq was the same
+// even number before and after; otherwise the writer got in the way and it
+// copies again. The writer never waits, a reader at worst copies twice.
+
+#define SEQLOCK_SPINS_BEFORE_SLEEP 64  // Then let the writer run if it is on our core
+
+struct TelemetryShared {
+  std::atomic<uint32_t> seq;
+  TelemetrySnapshot snap;
+  // How often each side got in the other's way, for /stats
+  std::atomic<uint32_t> publishes;   // Snapshots the writer put out
+  std::atomic<uint32_t> reads;       // Copies readers asked for
+  std::atomic<uint32_t> retries;     // Copies thrown away because the writer changed the snapshot meanwhile
+  std::atomic<uint32_t> waits;       // Times a reader found the writer mid-publish
+};
+
+// Writer side, only ever called from the acquisition task
+void telemetryPublish(TelemetryShared &shared, const TelemetrySnapshot &snap) {
+  uint32_t seq = shared.seq.load(std::memory_order_relaxed);
+  shared.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  shared.snap = snap;
+  std::atomic_thread_fence(std::memory_order_release);
+  shared.seq.store(seq + 2, std::memory_order_relaxed);
+  shared.publishes.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Reader side, safe from any task
+void telemetryRead(TelemetryShared &shared, TelemetrySnapshot &copy) {
+  uint32_t spins = 0;
+
+  shared.reads.fetch_add(1, std::memory_order_relaxed);
+  for (;;) {
+    uint32_t before = shared.seq.load(std::memory_order_acquire);
+    if (before & 1) { // Writer is mid-publish
+      shared.waits.fetch_add(1, std::memory_order_relaxed);
+      if (++spins >= SEQLOCK_SPINS_BEFORE_SLEEP) {
+        vTaskDelay(1); // We may have preempted it on this core
+        spins = 0;
+      }
+      continue;
+    }
+    copy = shared.snap;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (shared.seq.load(std::memory_order_relaxed) == before) {
+      return;
+    }
+    shared.retries.fetch_add(1, std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,192 @@
+// ===Trip log on the flash filesystem===
+//
+// The history ring (history.h) only lives in RAM, so it is gone whenever the
+// ESP32 loses power, including when /readRestartServer has the AVR128 power
+// cycle it. The trip log keeps the same encoded blocks on the LittleFS
+// partition, one file per trip, in the /history?format=bin layout:
+//
+//   /trips/00012.wmh   header, then whole blocks (see historyPackHeader())
+//
+// A trip starts at boot and whenever the AVR128 enters the EVIM or charge
+// state. A trip that outgrows TRIPLOG_MAX_FILE carries on in the next file.
+// Once the log takes more than TRIPLOG_FS_PERCENT of the partition the oldest
+// files are deleted, LittleFS itself spreads the writes over the flash.
+//
+// Only the logger task touches the files. loop() hands it finished blocks
+// through a queue and the task syncs a file once TRIPLOG_SYNC_BYTES have built
+// up (or a flush is asked for), so flash is programmed a page at a time rather
+// than once per sample.
+
+#define TRIPLOG_DIR          "/trips"
+#define TRIPLOG_MAX_FILE     (128UL * 1024)  // About 4 hours at 1 Hz
+#define TRIPLOG_FS_PERCENT   75              // Share of the partition the log may use
+#define TRIPLOG_SYNC_BYTES   4096            // One flash page
+#define TRIPLOG_QUEUE_DEPTH  8
+#define TRIPLOG_FLUSH_MS     60000           // Most a sample waits in RAM
+
+// What loop() can ask the logger task to do
+enum TripLogCommand {
+  TRIPLOG_BLOCK,      // Append block to the current trip
+  TRIPLOG_SYNC,       // Append block if it has records, then sync the file
+  TRIPLOG_NEW_TRIP    // Append block if it has records, then close the trip
+};
+
+struct TripLogMessage {
+  uint8_t command;
+  HistoryBlock block;
+};
+
+struct TripLog {
+  File file;              // Trip being written, closed when none
+  uint32_t trip;          // Number of that trip, 0 = none open
+  uint32_t nextTrip;      // Number the next trip gets
+  uint32_t unsynced;      // Bytes written since the last sync
+  size_t capBytes;        // TRIPLOG_FS_PERCENT of the partition
+  // Counters for /trips
+  uint32_t blocksWritten;
+  uint32_t writeErrors;
+  uint32_t filesDeleted;
+};
+
+void tripLogPath(char *out, size_t size, uint32_t trip) {
+  snprintf(out, size, TRIPLOG_DIR "/%05lu.wmh", (unsigned long)trip);
+}
+
+// Trip number from a file name, 0 if it is not a trip file
+uint32_t tripLogNumber(const char *name) {
+  const char *slash = strrchr(name, '/');
+  uint32_t trip = 0;
+  if (slash != NULL) {
+    name = slash + 1;
+  }
+  if (!isdigit((unsigned char)*name)) {
+    return 0;
+  }
+  while (isdigit((unsigned char)*name)) {
+    trip = trip * 10 + (*name++ - '0');
+  }
+  return strcmp(name, ".wmh") == 0 ? trip : 0;
+}
+
+// Lowest and highest trip numbers on flash, both 0 if there are none
+void tripLogScan(fs::FS &fs, uint32_t *oldest, uint32_t *newest) {
+  File dir = fs.open(TRIPLOG_DIR);
+  *oldest = 0;
+  *newest = 0;
+  if (!dir || !dir.isDirectory()) {
+    return;
+  }
+  for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+    uint32_t trip = tripLogNumber(f.name());
+    if (trip == 0) {
+      continue;
+    }
+    if (*oldest == 0 || trip < *oldest) {
+      *oldest = trip;
+    }
+    if (trip > *newest) {
+      *newest = trip;
+    }
+  }
+}
+
+// Call once the partition is mounted
+void tripLogBegin(TripLog &log) {
+  uint32_t oldest, newest;
+
+  if (!LittleFS.exists(TRIPLOG_DIR)) {
+    LittleFS.mkdir(TRIPLOG_DIR);
+  }
+  tripLogScan(LittleFS, &oldest, &newest);
+  log.trip = 0;
+  log.nextTrip = newest + 1;
+  log.unsynced = 0;
+  log.capBytes = LittleFS.totalBytes() / 100 * TRIPLOG_FS_PERCENT;
+}
+
+// Delete the oldest trips until the log fits its share of the partition
+void tripLogEnforceCap(TripLog &log) {
+  while (LittleFS.usedBytes() > log.capBytes) {
+    uint32_t oldest, newest;
+    char path[32];
+
+    tripLogScan(LittleFS, &oldest, &newest);
+    if (oldest == 0 || oldest == log.trip) {
+      return; // Only the trip being written is left
+    }
+    tripLogPath(path, sizeof(path), oldest);
+    if (!LittleFS.remove(path)) {
+      log.writeErrors++;
+      return;
+    }
+    log.filesDeleted++;
+  }
+}
+
+void tripLogClose(TripLog &log) {
+  if (log.trip != 0) {
+    log.file.close();
+    log.trip = 0;
+    log.unsynced = 0;
+  }
+}
+
+bool tripLogOpen(TripLog &log) {
+  uint8_t header[HISTORY_FILE_HEADER];
+  char path[32];
+
+  tripLogClose(log);
+  tripLogPath(path, sizeof(path), log.nextTrip);
+  log.file = LittleFS.open(path, "w");
+  if (!log.file) {
+    log.writeErrors++;
+    return false;
+  }
+  log.trip = log.nextTrip++;
+  log.file.write(header, historyPackHeader(header));
+  tripLogEnforceCap(log);
+  return true;
+}
+
+void tripLogSync(TripLog &log) {
+  if (log.trip != 0 && log.unsynced > 0) {
+    log.file.flush();
+    log.unsynced = 0;
+    tripLogEnforceCap(log);
+  }
+}
+
+void tripLogWrite(TripLog &log, const HistoryBlock &block) {
+  uint8_t packed[HISTORY_PACKED_MAX];
+  size_t n = historyPackBlock(packed, block);
+
+  if (log.trip != 0 && log.file.size() + n > TRIPLOG_MAX_FILE) {
+    tripLogSync(log);
+    tripLogClose(log); // Long trip, carry on in the next file
+  }
+  if (log.trip == 0 && !tripLogOpen(log)) {
+    return;
+  }
+  if (log.file.write(packed, n) != n) {
+    log.writeErrors++;
+    return;
+  }
+  log.blocksWritten++;
+  log.unsynced += n;
+  if (log.unsynced >= TRIPLOG_SYNC_BYTES) {
+    tripLogSync(log);
+  }
+}
+
+// Carry out one message from loop(), runs on the logger task
+void tripLogHandle(TripLog &log, const TripLogMessage &message) {
+  if (message.block.records > 0) {
+    tripLogWrite(log, message.block);
+  }
+  if (message.command == TRIPLOG_SYNC) {
+    tripLogSync(log);
+  } else if (message.command == TRIPLOG_NEW_TRIP) {
+    tripLogSync(log);
+    tripLogClose(log);
+  }
+}
@@ -0,0 +1,982 @@
+/*
+ * avr_emu.c - the AVR128's end of the ESP32 remote link, on a pseudo-terminal
+ *
+ * Answers everything ESP32_ISR_Remote_InterfaceRoutines.inc answers: the
+ * single letter commands 'a'..'n' and 'z', and the binary snapshot, relay
+ * cycle and OLED link frames, in the same formats and from the same kind of state (the
+ * SOCH response arrays, the aux voltage digits, scaled_temps_array).  The
+ * values come from a simulated car that drives and charges in turn, so they
+ * move the way they do on the bench.  Replies can be held back, jittered,
+ * lose bytes or pick up garbage to see how the ESP32 side copes.
+ *
+ * Every few seconds it prints how many of each request it answered, the
+ * transactions per second and the turnaround (last request byte in to last
+ * reply byte out), whatever the client is.  With -c it is the client
+ * instead: it sends requests back to back to a responder (this program, or
+ * the real AVR128 through a USB serial adapter) and reports the round trips.
+ *
+ *   cc -O2 -o avr_emu avr_emu.c -lm
+ *   ./avr_emu                             new pty, prints the name to open
+ *   ./avr_emu -d $(cat run/uart1.pty)     other end of esp32_host's UART1
+ *   ./avr_emu -c snapshot -d /dev/ttyUSB0 benchmark the real AVR128
+ *
+ *   -d device     serial device or pty to use (default: a new pty)
+ *   -b baud       pace bytes like a UART at this rate, 0 = as fast as
+ *                 possible (default 115200)
+ *   -l ms         extra delay before each reply (default 0)
+ *   -j ms         up to this much more, picked at random (default 0)
+ *   -x percent    chance of dropping each reply byte (default 0)
+ *   -g percent    chance of a garbage byte in front of each reply byte
+ *                 (default 0)
+ *   -s seconds    report interval, 0 = only at the end (default 5)
+ *   -P seconds    length of one drive and charge cycle of the car (default 600)
+ *   -S seed       random seed (default: the time)
+ *   -c mode       be the client: snapshot, dump ('n') or letters ('a'..'m')
+ *   -n count      client: requests to send (default 1000)
+ *   -i ms         client: gap between requests (default 0)
+ *   -t ms         client: give up on a reply after this long (default 200)
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../WMOS_AVR_Code/WMOS_AVR_Code/Dependencies/ESP32_ISR.h"
+
+#define REPLY_MAX       128     /* Longest reply, the 'n' line is about 100 */
+#define QUEUE_DEPTH     16      /* Replies waiting for their send time */
+#define RELAY_DEAF_US   30000   /* The 'z' _delay_ms(30) runs inside the RX ISR */
+#define CAPACITY_AH     100.0   /* Simulated pack */
+
+static const char *device;
+static long baud = 115200;
+static double latency_ms;
+static double jitter_ms;
+static double drop_percent;
+static double garbage_percent;
+static double report_s = 5;
+static double cycle_s = 600;
+static const char *client_mode;
+static long client_count = 1000;
+static double client_gap_ms;
+static double client_timeout_ms = 200;
+
+static int fd = -1;
+static volatile sig_atomic_t stop;
+
+static double now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static double uniform(void)
+{
+	return rand() / (RAND_MAX + 1.0);
+}
+
+static void on_signal(int sig)
+{
+	stop = 1;
+}
+
+static uint16_t crc16_update(uint16_t crc, uint8_t data)
+{
+	crc ^= (uint16_t)data << 8;
+	for (int i = 0; i < 8; i++)
+		crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+	return crc;
+}
+
+static size_t build_frame(uint8_t *out, uint8_t type, uint8_t seq, const uint8_t *payload, uint8_t len)
+{
+	uint16_t crc = 0xFFFF;
+	size_t n = 0;
+
+	out[n++] = REMOTE_SYNC;
+	out[n++] = len;
+	out[n++] = seq;
+	out[n++] = type;
+	memcpy(out + n, payload, len);
+	n += len;
+	for (size_t i = 1; i < n; i++)
+		crc = crc16_update(crc, out[i]);
+	out[n++] = crc & 0xFF;
+	out[n++] = crc >> 8;
+	return n;
+}
+
+/* ---Latency samples--- */
+
+struct samples {
+	double *us;
+	size_t count, size;
+};
+
+static void sample_add(struct samples *s, double us)
+{
+	if (s->count == s->size) {
+		s->size = s->size ? s->size * 2 : 1024;
+		s->us = realloc(s->us, s->size * sizeof(double));
+	}
+	s->us[s->count++] = us;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, size_t count, double p)
+{
+	size_t i = (size_t)(p / 100.0 * (count - 1) + 0.5);
+	return sorted[i];
+}
+
+/* "p50 1.2 ms  p99 3.4 ms  max 5.6 ms" of the samples, which get sorted */
+static void print_spread(struct samples *s)
+{
+	if (s->count == 0) {
+		printf("  no samples");
+		return;
+	}
+	qsort(s->us, s->count, sizeof(double), compare_double);
+	printf("  p50 %6.2f ms  p90 %6.2f ms  p99 %6.2f ms  max %6.2f ms",
+	       percentile(s->us, s->count, 50) / 1000, percentile(s->us, s->count, 90) / 1000,
+	       percentile(s->us, s->count, 99) / 1000, s->us[s->count - 1] / 1000);
+}
+
+/* ---The simulated car--- */
+
+struct car {
+	double t;          /* Seconds simulated */
+	double soc;        /* Percent */
+	double wh;         /* Pack energy counter */
+	double current;    /* Amps, positive while charging */
+	double volts;
+	double temp[6];    /* Degrees F, scaled_temps_array order: Ambient first, Motor last */
+	double aux5, aux12, accy;
+	uint8_t flags;
+};
+
+static struct car car = {
+	.soc = 80, .wh = -4321.1, .volts = 176.54,
+	.temp = {72, 75, 75, 80, 78, 76}, .aux5 = 5.02, .aux12 = 12.6, .accy = 13.3
+};
+
+static void car_step(double dt)
+{
+	double phase = fmod(car.t, cycle_s) / cycle_s;
+	double target[6];
+	double load;
+
+	car.t += dt;
+	car.flags = 0;
+	if (phase < 0.6) {
+		/* Driving: a base load with slow and quick swings, regen now and then */
+		car.current = -(40 + 35 * sin(car.t * 2 * M_PI / 23) + 15 * sin(car.t * 2 * M_PI / 7));
+		car.flags |= REMOTE_FLAG_EVIM_STATE;
+	} else if (phase >= 0.65 && phase < 0.95 && car.soc < 100) {
+		car.current = car.soc < 95 ? 20 : 4; /* Tapers off near full */
+		car.flags |= REMOTE_FLAG_CHARGE_CYCLE;
+	} else {
+		car.current = -0.5; /* Parked, the electronics still draw */
+	}
+
+	car.soc += car.current * dt / 3600 / CAPACITY_AH * 100;
+	car.soc = fmin(100, fmax(0, car.soc));
+	car.volts = 160 + 0.22 * car.soc + 0.05 * car.current;
+	car.wh += car.volts * car.current * dt / 3600;
+	car.wh = fmin(99999.9, fmax(-99999.9, car.wh));
+
+	load = fabs(car.current);
+	target[0] = 72 + 3 * sin(car.t * 2 * M_PI / 3600);   /* Ambient */
+	target[1] = target[0] + 0.2 * load;                  /* BBox 2 */
+	target[2] = target[0] + 0.25 * load;                 /* BBox 1 */
+	target[3] = target[0] + ((car.flags & REMOTE_FLAG_EVIM_STATE) ? 15 : 3);  /* DC-DC */
+	target[4] = target[0] + 0.8 * load;                  /* Controller */
+	target[5] = target[0] + 1.2 * load;                  /* Motor */
+	for (int i = 0; i < 6; i++)
+		car.temp[i] += (target[i] - car.temp[i]) * fmin(1, dt / 120);
+
+	car.aux5 = 5.02 + (uniform() - 0.5) * 0.04;
+	car.aux12 = ((car.flags & REMOTE_FLAG_EVIM_STATE) ? 13.8 : 12.6) + (uniform() - 0.5) * 0.1;
+	car.accy = 13.3 + (uniform() - 0.5) * 0.04;
+
+	if (car.soc >= 95)
+		car.flags |= REMOTE_FLAG_PACK_SOC95;
+	if (car.volts >= 178)
+		car.flags |= REMOTE_FLAG_PACK_VOLTAGE;
+}
+
+/* Bring the car up to now, a second at a time at most */
+static void car_update(double now)
+{
+	static double last;
+	double dt;
+
+	if (last == 0)
+		last = now;
+	dt = (now - last) / 1e6;
+	last = now;
+	while (dt > 0) {
+		double step = fmin(dt, 1.0);
+		car_step(step);
+		dt -= step;
+	}
+}
+
+/* ---What the AVR128 keeps, rendered from the car--- */
+
+static uint8_t pack_voltage_array[16];
+static uint8_t pack_current_array[16];
+static uint8_t pack_soc_array[16];
+static uint8_t pack_kwh_array[16];      /* Not NUL terminated, like on the AVR */
+static unsigned aux5_hundredths, aux12_hundredths, accy133_hundredths;
+static int16_t scaled_temps_array[6];
+
+static void render(void)
+{
+	char kwh[17];
+
+	snprintf((char *)pack_voltage_array, 16, " 60V %6.2fV", car.volts);
+	snprintf((char *)pack_current_array, 16, " 60C %+07.1fA", car.current);
+	snprintf((char *)pack_soc_array, 16, " 60G %.1f%%", car.soc);
+	snprintf(kwh, sizeof(kwh), " 60WH %+08.1fWH", car.wh);
+	memcpy(pack_kwh_array, kwh, 16);
+	aux5_hundredths = (unsigned)lround(car.aux5 * 100);
+	aux12_hundredths = (unsigned)lround(car.aux12 * 100);
+	accy133_hundredths = (unsigned)lround(car.accy * 100);
+	for (int i = 0; i < 6; i++)
+		scaled_temps_array[i] = (int16_t)lround(car.temp[i] * 10);
+}
+
+/* "%u%u.%u%u" of the tens, units, tenths and hundredths digits */
+static int aux_text(char *out, size_t size, unsigned hundredths)
+{
+	return snprintf(out, size, "%u%u.%u%u", hundredths / 1000 % 10, hundredths / 100 % 10,
+	                hundredths / 10 % 10, hundredths % 10);
+}
+
+/* Same as send_snapshot_frame()'s pack_array_value() */
+static int32_t pack_array_value(const uint8_t *array, int start)
+{
+	int32_t value = 0;
+	int negative = 0;
+	int i = start;
+
+	while (i < 16 && array[i] == ' ')
+		i++;
+	if (i < 16 && (array[i] == '+' || array[i] == '-')) {
+		negative = array[i] == '-';
+		i++;
+	}
+	for (; i < 16; i++) {
+		if (array[i] >= '0' && array[i] <= '9')
+			value = value * 10 + (array[i] - '0');
+		else if (array[i] != '.')
+			break;
+	}
+	return negative ? -value : value;
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+	p[0] = v & 0xFF;
+	p[1] = v >> 8;
+}
+
+/* ---Replies, paced out at the UART rate--- */
+
+struct reply {
+	double due;          /* When the first byte may go */
+	double request_at;   /* When the request's last byte arrived */
+	size_t len, sent;
+	uint8_t data[2 * REPLY_MAX];   /* Room for garbage */
+};
+
+static struct reply queue[QUEUE_DEPTH];
+static int queue_head, queue_count;
+static double line_free_at;      /* When the UART finishes the last byte handed to it */
+static double deaf_until;        /* Relay cycle in progress, nothing is read */
+
+/* Counters, reset at each report */
+enum { K_LETTER, K_DUMP, K_RELAY_Z, K_SNAPSHOT, K_RELAY, K_OLED, K_NAK, K_IGNORED, K_CRC, K_KINDS };
+static const char *kind_names[K_KINDS] = {
+	"letters", "dump", "z", "snapshot", "relay", "oled", "nak", "ignored", "crc"
+};
+static unsigned long kinds[K_KINDS], kinds_total[K_KINDS];
+static unsigned long bytes_in, bytes_out, bytes_dropped, bytes_garbage, queue_full;
+static struct samples turnaround, turnaround_total;
+
+static double byte_us(void)
+{
+	return baud > 0 ? 10e6 / baud : 0; /* 8N1: start, 8 data, stop */
+}
+
+static void send_reply(const uint8_t *data, size_t len, double request_at)
+{
+	struct reply *r;
+	double due = request_at + (latency_ms + uniform() * jitter_ms) * 1000;
+
+	if (queue_count == QUEUE_DEPTH) {
+		queue_full++;
+		return;
+	}
+	r = &queue[(queue_head + queue_count++) % QUEUE_DEPTH];
+	r->request_at = request_at;
+	r->len = 0;
+	r->sent = 0;
+	r->due = due;
+	for (size_t i = 0; i < len; i++) {
+		if (uniform() * 100 < garbage_percent) {
+			r->data[r->len++] = (uint8_t)rand();
+			bytes_garbage++;
+		}
+		if (uniform() * 100 < drop_percent) {
+			bytes_dropped++;
+			continue;
+		}
+		r->data[r->len++] = data[i];
+	}
+}
+
+/* Write what the UART would have sent by now; returns microseconds until more is due */
+static double pump_output(double now)
+{
+	while (queue_count > 0) {
+		struct reply *r = &queue[queue_head];
+		double start = r->due > line_free_at ? r->due : line_free_at;
+		size_t allowed;
+		ssize_t n;
+
+		if (now < start)
+			return start - now;
+		if (r->sent == 0)
+			line_free_at = start;
+		if (baud > 0) {
+			allowed = (size_t)((now - line_free_at) / byte_us()) + 1;
+			if (allowed > r->len - r->sent)
+				allowed = r->len - r->sent;
+		} else {
+			allowed = r->len - r->sent;
+		}
+		n = allowed > 0 ? write(fd, r->data + r->sent, allowed) : 0;
+		if (n < 0) {
+			if (errno == EAGAIN || errno == EIO)
+				return 1000; /* Nobody listening yet, or the pty is full */
+			perror("write");
+			stop = 1;
+			return 0;
+		}
+		r->sent += n;
+		line_free_at += n * byte_us();
+		bytes_out += n;
+		if (r->sent < r->len)
+			return byte_us() > 0 ? byte_us() : 100;
+		sample_add(&turnaround, fmax(now, line_free_at) - r->request_at);
+		queue_head = (queue_head + 1) % QUEUE_DEPTH;
+		queue_count--;
+	}
+	return -1;
+}
+
+/* ---executeCommand()--- */
+
+static void reply_text(const char *text, double at)
+{
+	uint8_t out[REPLY_MAX];
+	size_t len = strlen(text);
+	if (len > REPLY_MAX - 1)
+		len = REPLY_MAX - 1;
+
+	memcpy(out, text, len);
+	out[len++] = '\n';
+	send_reply(out, len, at);
+}
+
+/* The 'n' line: $WMOS,<a>,...,<m>,<flags>*CS */
+static void dump_line(char *out, size_t size)
+{
+	char temp[30];
+	size_t n = 0;
+	uint8_t cs = 0;
+
+	/* Fields the way USART5_sendFrameField() sends them */
+#define FIELD(str, max) do { \
+		const char *f_ = (str); \
+		out[n++] = ','; \
+		for (size_t i_ = 0; i_ < (max) && f_[i_] != '\0' && n < size - 8; i_++) { \
+			char c_ = f_[i_]; \
+			if (c_ == ',' || c_ == '*' || c_ == '$' || c_ == '\r' || c_ == '\n') \
+				c_ = ' '; \
+			out[n++] = c_; \
+		} \
+	} while (0)
+
+	n += snprintf(out, size, "$WMOS");
+	FIELD((char *)pack_voltage_array, 16);
+	FIELD((char *)pack_current_array, 16);
+	FIELD((char *)pack_soc_array, 16);
+	FIELD((char *)pack_kwh_array, 16);
+	aux_text(temp, sizeof(temp), aux5_hundredths);
+	FIELD(temp, sizeof(temp));
+	aux_text(temp, sizeof(temp), aux12_hundredths);
+	FIELD(temp, sizeof(temp));
+	aux_text(temp, sizeof(temp), accy133_hundredths);
+	FIELD(temp, sizeof(temp));
+	for (int i = 5; i >= 0; i--) {
+		snprintf(temp, sizeof(temp), "%d", scaled_temps_array[i]);
+		FIELD(temp, sizeof(temp));
+	}
+	snprintf(temp, sizeof(temp), "%02X", car.flags);
+	FIELD(temp, sizeof(temp));
+#undef FIELD
+
+	for (size_t i = 1; i < n; i++)
+		cs ^= (uint8_t)out[i];
+	snprintf(out + n, size - n, "*%02X", cs);
+}
+
+static void execute_command(const char *command, double at)
+{
+	char temp[REPLY_MAX];
+	char kwh[17];
+
+	render();
+	if (strlen(command) == 1 && command[0] >= 'a' && command[0] <= 'm') {
+		switch (command[0]) {
+		case 'a': reply_text((char *)pack_voltage_array, at); break;
+		case 'b': reply_text((char *)pack_current_array, at); break;
+		case 'c': reply_text((char *)pack_soc_array, at); break;
+		case 'd':
+			memcpy(kwh, pack_kwh_array, 16);
+			kwh[16] = '\0';
+			reply_text(kwh, at);
+			break;
+		case 'e': aux_text(temp, sizeof(temp), aux5_hundredths); reply_text(temp, at); break;
+		case 'f': aux_text(temp, sizeof(temp), aux12_hundredths); reply_text(temp, at); break;
+		case 'g': aux_text(temp, sizeof(temp), accy133_hundredths); reply_text(temp, at); break;
+		default:
+			/* 'h' is Motor (scaled_temps_array[5]) down to 'm', Ambient; "%hu" like the AVR */
+			snprintf(temp, sizeof(temp), "%hu", (unsigned short)scaled_temps_array['m' - command[0]]);
+			reply_text(temp, at);
+			break;
+		}
+		kinds[K_LETTER]++;
+	} else if (strcmp(command, "n") == 0) {
+		dump_line(temp, sizeof(temp));
+		reply_text(temp, at);
+		kinds[K_DUMP]++;
+	} else if (strcmp(command, "z") == 0) {
+		deaf_until = at + RELAY_DEAF_US;
+		kinds[K_RELAY_Z]++;
+	} else {
+		kinds[K_IGNORED]++;
+	}
+}
+
+/* ---executeFrame()--- */
+
+static void execute_frame(uint8_t type, uint8_t seq, const uint8_t *payload, uint8_t len, double at)
+{
+	uint8_t frame[REMOTE_MAX_PAYLOAD + 6];
+	uint8_t snap[REMOTE_SNAPSHOT_LEN];
+	int32_t kwh;
+	/* What oled_init() usually settles on: two at the fastest rate, one fell back */
+	static const uint32_t oled_baud[3] = { 115385, 115385, 57692 };
+
+	switch (type) {
+	case REMOTE_TYPE_SNAPSHOT:
+		render();
+		put16(&snap[SNAP_PACK_VOLTAGE], (uint16_t)pack_array_value(pack_voltage_array, 4));
+		put16(&snap[SNAP_PACK_CURRENT], (uint16_t)pack_array_value(pack_current_array, 4));
+		put16(&snap[SNAP_PACK_SOC], (uint16_t)pack_array_value(pack_soc_array, 4));
+		kwh = pack_array_value(pack_kwh_array, 5);
+		put16(&snap[SNAP_PACK_KWH], (uint32_t)kwh & 0xFFFF);
+		put16(&snap[SNAP_PACK_KWH + 2], (uint32_t)kwh >> 16);
+		put16(&snap[SNAP_AUX5], aux5_hundredths);
+		put16(&snap[SNAP_AUX12], aux12_hundredths);
+		put16(&snap[SNAP_ACCY133], accy133_hundredths);
+		for (int i = 0; i < 6; i++)
+			put16(&snap[SNAP_TEMPS + 2 * i], (uint16_t)scaled_temps_array[5 - i]);
+		snap[SNAP_FLAGS] = car.flags;
+		send_reply(frame, build_frame(frame, REMOTE_TYPE_SNAPSHOT | REMOTE_TYPE_REPLY, seq,
+		                              snap, REMOTE_SNAPSHOT_LEN), at);
+		kinds[K_SNAPSHOT]++;
+		break;
+
+	case REMOTE_TYPE_RELAY_CYCLE:
+		send_reply(frame, build_frame(frame, type | REMOTE_TYPE_REPLY, seq, payload, 0), at);
+		deaf_until = at + RELAY_DEAF_US;
+		kinds[K_RELAY]++;
+		break;
+
+	case REMOTE_TYPE_OLED_LINK:
+		for (int i = 0; i < 3; i++) {
+			put16(&snap[4 * i], oled_baud[i] & 0xFFFF);
+			put16(&snap[4 * i + 2], oled_baud[i] >> 16);
+		}
+		send_reply(frame, build_frame(frame, REMOTE_TYPE_OLED_LINK | REMOTE_TYPE_REPLY, seq,
+		                              snap, REMOTE_OLED_LINK_LEN), at);
+		kinds[K_OLED]++;
+		break;
+
+	default:
+		send_reply(frame, build_frame(frame, REMOTE_TYPE_NAK, seq, &type, 1), at);
+		kinds[K_NAK]++;
+		break;
+	}
+}
+
+/* ---The USART5 RX ISR--- */
+
+static char command[50];
+static uint8_t cmd_index;
+static uint8_t rx_state = REMOTE_RX_IDLE;
+static uint8_t rx_len, rx_seq, rx_type, rx_count;
+static uint16_t rx_crc;
+static uint8_t rx_payload[REMOTE_MAX_PAYLOAD];
+
+static void rx_byte(uint8_t data, double at)
+{
+	switch (rx_state) {
+	case REMOTE_RX_IDLE:
+		rx_crc = 0xFFFF;
+		rx_state = REMOTE_RX_LEN;
+		break;
+	case REMOTE_RX_LEN:
+		if (data > REMOTE_MAX_PAYLOAD) {
+			rx_state = REMOTE_RX_IDLE;
+			break;
+		}
+		rx_len = data;
+		rx_count = 0;
+		rx_crc = crc16_update(rx_crc, data);
+		rx_state = REMOTE_RX_SEQ;
+		break;
+	case REMOTE_RX_SEQ:
+		rx_seq = data;
+		rx_crc = crc16_update(rx_crc, data);
+		rx_state = REMOTE_RX_TYPE;
+		break;
+	case REMOTE_RX_TYPE:
+		rx_type = data;
+		rx_crc = crc16_update(rx_crc, data);
+		rx_state = rx_len > 0 ? REMOTE_RX_PAYLOAD : REMOTE_RX_CRC_L;
+		break;
+	case REMOTE_RX_PAYLOAD:
+		rx_payload[rx_count++] = data;
+		rx_crc = crc16_update(rx_crc, data);
+		if (rx_count >= rx_len)
+			rx_state = REMOTE_RX_CRC_L;
+		break;
+	case REMOTE_RX_CRC_L:
+		if (data != (rx_crc & 0xFF)) {
+			kinds[K_CRC]++;
+			rx_state = REMOTE_RX_IDLE;
+			break;
+		}
+		rx_state = REMOTE_RX_CRC_H;
+		break;
+	case REMOTE_RX_CRC_H:
+		rx_state = REMOTE_RX_IDLE;
+		if (data == (rx_crc >> 8))
+			execute_frame(rx_type, rx_seq, rx_payload, rx_len, at);
+		else
+			kinds[K_CRC]++;
+		break;
+	default:
+		rx_state = REMOTE_RX_IDLE;
+		break;
+	}
+}
+
+static void isr(uint8_t c, double at)
+{
+	if (rx_state != REMOTE_RX_IDLE || (cmd_index == 0 && c == REMOTE_SYNC)) {
+		rx_byte(c, at);
+		return;
+	}
+	if (c != '\n' && c != '\r') {
+		command[cmd_index++] = c;
+		if (cmd_index >= sizeof(command) - 1)
+			cmd_index = 0;
+	}
+	if (c == '\n') {
+		command[cmd_index] = '\0';
+		cmd_index = 0;
+		execute_command(command, at);
+	}
+}
+
+/* ---Reports--- */
+
+static void report(double seconds, unsigned long *counts, struct samples *s)
+{
+	unsigned long transactions = 0;
+
+	for (int k = 0; k < K_KINDS; k++) {
+		if (k != K_IGNORED && k != K_CRC)
+			transactions += counts[k];
+	}
+	printf("%7.1f s %8.1f tps ", car.t, seconds > 0 ? transactions / seconds : 0.0);
+	for (int k = 0; k < K_KINDS; k++) {
+		if (counts[k] > 0)
+			printf(" %s %lu", kind_names[k], counts[k]);
+	}
+	print_spread(s);
+	printf("\n");
+}
+
+static void report_interval(double seconds)
+{
+	report(seconds, kinds, &turnaround);
+	for (int k = 0; k < K_KINDS; k++) {
+		kinds_total[k] += kinds[k];
+		kinds[k] = 0;
+	}
+	for (size_t i = 0; i < turnaround.count; i++)
+		sample_add(&turnaround_total, turnaround.us[i]);
+	turnaround.count = 0;
+	fflush(stdout);
+}
+
+/* ---Responder--- */
+
+static int run_responder(void)
+{
+	double start = now_us();
+	double last_report = start;
+
+	printf("answering as the AVR128, %ld baud, latency %.1f+%.1f ms, drop %.2f%%, garbage %.2f%%\n",
+	       baud, latency_ms, jitter_ms, drop_percent, garbage_percent);
+	fflush(stdout);
+
+	while (!stop) {
+		struct pollfd p = {fd, POLLIN, 0};
+		double now = now_us();
+		double wait = pump_output(now);
+		double next_report = report_s > 0 ? last_report + report_s * 1e6 - now : -1;
+		int timeout;
+
+		if (wait < 0 || (next_report >= 0 && next_report < wait))
+			wait = next_report;
+		timeout = wait < 0 ? 1000 : (int)(wait / 1000);
+		if (poll(&p, 1, timeout) < 0 && errno != EINTR)
+			break;
+
+		now = now_us();
+		car_update(now);
+		if (p.revents & POLLIN) {
+			uint8_t buf[256];
+			ssize_t n = read(fd, buf, sizeof(buf));
+			for (ssize_t i = 0; i < n; i++) {
+				bytes_in++;
+				if (now < deaf_until)
+					continue; /* Busy in the relay delay, RX overruns */
+				isr(buf[i], now);
+			}
+		} else if (p.revents & POLLHUP) {
+			usleep(10000); /* Other end of the pty not open (yet) */
+		}
+
+		if (report_s > 0 && now - last_report >= report_s * 1e6) {
+			report_interval((now - last_report) / 1e6);
+			last_report = now;
+		}
+	}
+
+	report_interval((now_us() - last_report) / 1e6);
+	printf("total:  ");
+	report((now_us() - start) / 1e6, kinds_total, &turnaround_total);
+	printf("bytes in %lu out %lu, dropped %lu, garbage %lu, replies lost to a full queue %lu\n",
+	       bytes_in, bytes_out, bytes_dropped, bytes_garbage, queue_full);
+	return 0;
+}
+
+/* ---Client--- */
+
+/* Send request bytes paced like the ESP32's UART */
+static void client_send(const uint8_t *data, size_t len)
+{
+	for (size_t done = 0; done < len;) {
+		ssize_t n = write(fd, data + done, len - done);
+		if (n > 0)
+			done += n;
+		else if (n < 0 && errno != EAGAIN && errno != EINTR)
+			return;
+		else
+			usleep(100);
+	}
+	if (baud > 0)
+		usleep((useconds_t)(len * byte_us()));
+}
+
+/* Parser for the replies, same as avrParseByte() in avr_link.h */
+struct frame_parser {
+	int state;
+	uint8_t len, seq, type, count;
+	uint16_t crc;
+	uint8_t payload[REMOTE_MAX_PAYLOAD];
+};
+
+/* 1 when data completes a good frame, -1 when it completes a bad one */
+static int parse_frame_byte(struct frame_parser *p, uint8_t data)
+{
+	switch (p->state) {
+	case REMOTE_RX_IDLE:
+		if (data == REMOTE_SYNC) {
+			p->crc = 0xFFFF;
+			p->state = REMOTE_RX_LEN;
+		}
+		return 0;
+	case REMOTE_RX_LEN:
+		if (data > REMOTE_MAX_PAYLOAD) {
+			p->state = data == REMOTE_SYNC ? REMOTE_RX_LEN : REMOTE_RX_IDLE;
+			return 0;
+		}
+		p->len = data;
+		p->count = 0;
+		p->crc = crc16_update(p->crc, data);
+		p->state = REMOTE_RX_SEQ;
+		return 0;
+	case REMOTE_RX_SEQ:
+		p->seq = data;
+		p->crc = crc16_update(p->crc, data);
+		p->state = REMOTE_RX_TYPE;
+		return 0;
+	case REMOTE_RX_TYPE:
+		p->type = data;
+		p->crc = crc16_update(p->crc, data);
+		p->state = p->len > 0 ? REMOTE_RX_PAYLOAD : REMOTE_RX_CRC_L;
+		return 0;
+	case REMOTE_RX_PAYLOAD:
+		p->payload[p->count++] = data;
+		p->crc = crc16_update(p->crc, data);
+		if (p->count >= p->len)
+			p->state = REMOTE_RX_CRC_L;
+		return 0;
+	case REMOTE_RX_CRC_L:
+		if (data != (p->crc & 0xFF)) {
+			p->state = REMOTE_RX_IDLE;
+			return -1;
+		}
+		p->state = REMOTE_RX_CRC_H;
+		return 0;
+	case REMOTE_RX_CRC_H:
+		p->state = REMOTE_RX_IDLE;
+		return data == (p->crc >> 8) ? 1 : -1;
+	}
+	p->state = REMOTE_RX_IDLE;
+	return 0;
+}
+
+/* A '$WMOS' line whose checksum matches */
+static int dump_line_ok(const char *line)
+{
+	const char *star = strrchr(line, '*');
+	uint8_t cs = 0;
+
+	if (strncmp(line, "$WMOS,", 6) != 0 || star == NULL)
+		return 0;
+	for (const char *c = line + 1; c < star; c++)
+		cs ^= (uint8_t)*c;
+	return strtoul(star + 1, NULL, 16) == cs && strlen(star + 1) == 2;
+}
+
+static int run_client(void)
+{
+	int binary = strcmp(client_mode, "snapshot") == 0;
+	int dump = strcmp(client_mode, "dump") == 0;
+	struct frame_parser parser = {0};
+	struct samples rtt = {0};
+	unsigned long ok = 0, timeouts = 0, bad = 0;
+	char line[REPLY_MAX * 2];
+	size_t line_len = 0;
+	uint8_t seq = 0;
+	double start;
+
+	if (!binary && !dump && strcmp(client_mode, "letters") != 0) {
+		fprintf(stderr, "unknown client mode %s (snapshot, dump or letters)\n", client_mode);
+		return 2;
+	}
+	printf("client: %ld %s requests, %ld baud, timeout %.0f ms\n", client_count, client_mode, baud,
+	       client_timeout_ms);
+	fflush(stdout);
+	tcflush(fd, TCIFLUSH);
+
+	start = now_us();
+	for (long i = 0; i < client_count && !stop; i++) {
+		uint8_t request[REMOTE_MAX_PAYLOAD + 6];
+		size_t len;
+		double sent, deadline;
+		int result = 0;
+
+		if (binary) {
+			len = build_frame(request, REMOTE_TYPE_SNAPSHOT, ++seq, NULL, 0);
+		} else {
+			request[0] = dump ? 'n' : 'a' + i % 13;
+			request[1] = '\n';
+			len = 2;
+		}
+		sent = now_us();
+		client_send(request, len);
+		deadline = sent + client_timeout_ms * 1000;
+		line_len = 0;
+
+		while (result == 0 && !stop) {
+			double now = now_us();
+			struct pollfd p = {fd, POLLIN, 0};
+			uint8_t buf[256];
+			ssize_t n;
+
+			if (now >= deadline) {
+				result = -2;
+				break;
+			}
+			if (poll(&p, 1, (int)((deadline - now) / 1000) + 1) <= 0)
+				continue;
+			n = read(fd, buf, sizeof(buf));
+			for (ssize_t k = 0; k < n && result == 0; k++) {
+				if (binary) {
+					int r = parse_frame_byte(&parser, buf[k]);
+					if (r > 0 && parser.seq == seq &&
+					    parser.type == (REMOTE_TYPE_SNAPSHOT | REMOTE_TYPE_REPLY) &&
+					    parser.len == REMOTE_SNAPSHOT_LEN)
+						result = 1;
+					else if (r < 0)
+						bad++; /* Keep waiting, the real reply may still come */
+				} else if (buf[k] == '\n') {
+					line[line_len] = '\0';
+					result = (!dump || dump_line_ok(line)) && line_len > 0 ? 1 : -1;
+				} else if (line_len < sizeof(line) - 1) {
+					line[line_len++] = buf[k];
+				}
+			}
+		}
+
+		if (result == 1) {
+			ok++;
+			sample_add(&rtt, now_us() - sent);
+		} else if (result == -2) {
+			timeouts++;
+			parser.state = REMOTE_RX_IDLE;
+		} else if (result == -1) {
+			bad++;
+		}
+		if (client_gap_ms > 0)
+			usleep((useconds_t)(client_gap_ms * 1000));
+	}
+
+	double elapsed = (now_us() - start) / 1e6;
+	printf("%lu ok, %lu timeouts, %lu bad in %.2f s: %.1f tps\n", ok, timeouts, bad, elapsed,
+	       elapsed > 0 ? ok / elapsed : 0.0);
+	printf("round trip");
+	print_spread(&rtt);
+	printf("\n");
+	return ok > 0 ? 0 : 1;
+}
+
+/* ---Setup--- */
+
+static speed_t baud_constant(long rate)
+{
+	switch (rate) {
+	case 9600:   return B9600;
+	case 19200:  return B19200;
+	case 38400:  return B38400;
+	case 57600:  return B57600;
+	case 115200: return B115200;
+	case 230400: return B230400;
+	case 460800: return B460800;
+	case 921600: return B921600;
+	default:     return 0;
+	}
+}
+
+static int open_port(void)
+{
+	struct termios tio;
+	int keep;
+
+	if (device != NULL) {
+		fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+		if (fd < 0) {
+			fprintf(stderr, "can't open %s: %s\n", device, strerror(errno));
+			return -1;
+		}
+	} else {
+		fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+		if (fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0) {
+			perror("pty");
+			return -1;
+		}
+		/* Hold the slave open too, so the master doesn't hang up between clients */
+		keep = open(ptsname(fd), O_RDWR | O_NOCTTY);
+		if (keep >= 0 && tcgetattr(keep, &tio) == 0) {
+			cfmakeraw(&tio);
+			tcsetattr(keep, TCSANOW, &tio);
+		}
+		printf("AVR128 end of the link: %s\n", ptsname(fd));
+	}
+
+	if (tcgetattr(fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		if (baud_constant(baud) != 0)
+			cfsetspeed(&tio, baud_constant(baud)); /* Matters for a real serial port only */
+		tcsetattr(fd, TCSANOW, &tio);
+	}
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned seed = (unsigned)time(NULL);
+	int opt;
+
+	while ((opt = getopt(argc, argv, "d:b:l:j:x:g:s:P:S:c:n:i:t:")) != -1) {
+		switch (opt) {
+		case 'd': device = optarg; break;
+		case 'b': baud = atol(optarg); break;
+		case 'l': latency_ms = atof(optarg); break;
+		case 'j': jitter_ms = atof(optarg); break;
+		case 'x': drop_percent = atof(optarg); break;
+		case 'g': garbage_percent = atof(optarg); break;
+		case 's': report_s = atof(optarg); break;
+		case 'P': cycle_s = atof(optarg); break;
+		case 'S': seed = (unsigned)strtoul(optarg, NULL, 0); break;
+		case 'c': client_mode = optarg; break;
+		case 'n': client_count = atol(optarg); break;
+		case 'i': client_gap_ms = atof(optarg); break;
+		case 't': client_timeout_ms = atof(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-d device] [-b baud] [-l ms] [-j ms] [-x %%] [-g %%] [-s s] [-P s] [-S seed]\n"
+			                "       %s -c snapshot|dump|letters [-d device] [-b baud] [-n count] [-i ms] [-t ms]\n",
+			        argv[0], argv[0]);
+			return 2;
+		}
+	}
+	if (cycle_s <= 0)
+		cycle_s = 600;
+	srand(seed);
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+
+	if (open_port() < 0)
+		return 1;
+	return client_mode != NULL ? run_client() : run_responder();
+}
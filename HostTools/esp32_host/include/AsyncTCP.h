@@ -0,0 +1,5 @@
+/*
+ * AsyncTCP.h - nothing to do on the host, ESPAsyncWebServer.h uses sockets
+ */
+
+#pragma once
@@ -0,0 +1,43 @@
+/*
+ * EEPROM.h - EEPROM emulation for the host build, kept in a file
+ *
+ * begin() loads ESP32_HOST_EEPROM (zeros if it does not exist yet, like a
+ * fresh NVS blob) and commit() writes the whole image back.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+class EEPROMClass {
+public:
+	bool begin(size_t size);
+	uint8_t read(int address) const;
+	void write(int address, uint8_t value);
+	bool commit();
+	size_t length() const { return data_.size(); }
+	uint8_t *getDataPtr() { return data_.data(); }
+	uint32_t commits() const { return commits_; }
+
+	template <class T> T &get(int address, T &t)
+	{
+		if (address >= 0 && address + sizeof(T) <= data_.size())
+			memcpy(&t, data_.data() + address, sizeof(T));
+		return t;
+	}
+	template <class T> const T &put(int address, const T &t)
+	{
+		if (address >= 0 && address + sizeof(T) <= data_.size())
+			memcpy(data_.data() + address, &t, sizeof(T));
+		return t;
+	}
+
+private:
+	std::vector<uint8_t> data_;
+	uint32_t commits_ = 0;
+};
+
+extern EEPROMClass EEPROM;
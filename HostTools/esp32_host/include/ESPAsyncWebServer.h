@@ -0,0 +1,197 @@
+/*
+ * ESPAsyncWebServer.h - the async web server API over Linux sockets
+ *
+ * One server thread plays the part of the async_tcp task: it accepts
+ * connections, parses requests and calls the handlers, then writes the
+ * response without blocking.  Chunked responses call their filler only
+ * when the socket can take more, in 1460 byte pieces like one TCP segment
+ * on the ESP32.  As on the device every response ends with
+ * "Connection: close", so a benchmark pays for a new connection each time.
+ *
+ * AsyncEventSource keeps its subscribers' sockets open; send() may be
+ * called from any thread.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "FS.h"
+
+typedef enum {
+	HTTP_GET     = 0x01,
+	HTTP_POST    = 0x02,
+	HTTP_DELETE  = 0x04,
+	HTTP_PUT     = 0x08,
+	HTTP_PATCH   = 0x10,
+	HTTP_HEAD    = 0x20,
+	HTTP_OPTIONS = 0x40,
+	HTTP_ANY     = 0x7F
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+struct HostConnection;
+
+typedef std::function<size_t(uint8_t *buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+
+class AsyncWebHeader {
+public:
+	AsyncWebHeader(const String &name, const String &value) : name_(name), value_(value) {}
+	const String &name() const { return name_; }
+	const String &value() const { return value_; }
+
+private:
+	String name_, value_;
+};
+
+class AsyncWebServerResponse {
+public:
+	virtual ~AsyncWebServerResponse() {}
+	void addHeader(const String &name, const String &value) { headers_.push_back(AsyncWebHeader(name, value)); }
+	void setCode(int code) { code_ = code; }
+	void setContentType(const String &type) { contentType_ = type; }
+
+protected:
+	friend class AsyncWebServerRequest;
+	friend class AsyncWebServer;
+
+	int code_ = 200;
+	String contentType_;
+	std::vector<AsyncWebHeader> headers_;
+	std::string body_;            // Whole body, unless filler_ is set
+	AwsResponseFiller filler_;    // Chunked body
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+public:
+	size_t write(uint8_t c) override { body_.push_back((char)c); return 1; }
+	size_t write(const uint8_t *buf, size_t len) override { body_.append((const char *)buf, len); return len; }
+	using Print::write;
+};
+
+class AsyncWebServerRequest {
+public:
+	~AsyncWebServerRequest();
+
+	const String &url() const { return url_; }
+	WebRequestMethodComposite method() const { return method_; }
+
+	bool hasArg(const char *name) const { return args_.count(name) != 0; }
+	const String &arg(const char *name) const;
+	const String &arg(const String &name) const { return arg(name.c_str()); }
+	size_t args() const { return args_.size(); }
+
+	bool hasHeader(const String &name) const { return getHeader(name) != NULL; }
+	AsyncWebHeader *getHeader(const String &name) const;
+
+	void send(int code, const String &contentType = String(), const String &content = String());
+	void send(AsyncWebServerResponse *response);
+	AsyncWebServerResponse *beginResponse(int code, const String &contentType = String(),
+	                                      const String &content = String());
+	AsyncWebServerResponse *beginResponse_P(int code, const String &contentType, const uint8_t *content,
+	                                        size_t len);
+	AsyncWebServerResponse *beginChunkedResponse(const String &contentType, AwsResponseFiller filler);
+	AsyncResponseStream *beginResponseStream(const String &contentType, size_t bufferSize = 1460);
+
+private:
+	friend class AsyncWebServer;
+
+	String url_;
+	WebRequestMethodComposite method_ = HTTP_GET;
+	std::map<std::string, String> args_;
+	std::vector<AsyncWebHeader *> headers_;
+	AsyncWebServerResponse *response_ = NULL;
+};
+
+class AsyncWebHandler {
+public:
+	virtual ~AsyncWebHandler() {}
+};
+
+class AsyncEventSource;
+
+class AsyncEventSourceClient {
+public:
+	void send(const char *message, const char *event = NULL, uint32_t id = 0, uint32_t reconnect = 0);
+	uint32_t lastId() const { return lastId_; }
+	bool connected() const { return connection_ != NULL; }
+
+private:
+	friend class AsyncEventSource;
+	friend class AsyncWebServer;
+
+	AsyncEventSource *source_ = NULL;
+	HostConnection *connection_ = NULL;
+	uint32_t lastId_ = 0;
+};
+
+typedef std::function<void(AsyncEventSourceClient *client)> ArEventHandlerFunction;
+
+class AsyncEventSource : public AsyncWebHandler {
+public:
+	AsyncEventSource(const String &url) : url_(url) {}
+	void onConnect(ArEventHandlerFunction handler) { onConnect_ = handler; }
+	void send(const char *message, const char *event = NULL, uint32_t id = 0, uint32_t reconnect = 0);
+	size_t count() const;
+	const String &url() const { return url_; }
+
+private:
+	friend class AsyncWebServer;
+	friend class AsyncEventSourceClient;
+
+	String url_;
+	ArEventHandlerFunction onConnect_;
+	std::vector<AsyncEventSourceClient *> clients_;   // Guarded by the server lock
+	AsyncWebServer *server_ = NULL;
+};
+
+class AsyncWebServer {
+public:
+	AsyncWebServer(uint16_t port);
+	~AsyncWebServer();
+
+	void on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction handler);
+	void on(const char *uri, ArRequestHandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+	void onNotFound(ArRequestHandlerFunction handler) { notFound_ = handler; }
+	void addHandler(AsyncWebHandler *handler);
+	void begin();
+	void end();
+
+private:
+	friend class AsyncEventSource;
+	friend class AsyncEventSourceClient;
+
+	struct Route {
+		std::string uri;
+		WebRequestMethodComposite method;
+		ArRequestHandlerFunction handler;
+	};
+
+	static void *threadMain(void *arg);
+	void run();
+	void handleReadable(HostConnection *c);
+	bool parseRequest(HostConnection *c);
+	void dispatch(HostConnection *c, AsyncWebServerRequest *request);
+	void queueResponse(HostConnection *c, AsyncWebServerResponse *response);
+	void fillChunk(HostConnection *c);
+	void closeConnection(HostConnection *c);
+	void queueOutput(HostConnection *c, const std::string &data);
+	void wake();
+
+	uint16_t port_;
+	int listenFd_ = -1;
+	int wakePipe_[2] = {-1, -1};
+	pthread_t thread_;
+	bool running_ = false;
+	pthread_mutex_t lock_;
+	std::vector<Route> routes_;
+	std::vector<AsyncEventSource *> sources_;
+	std::vector<HostConnection *> connections_;
+	ArRequestHandlerFunction notFound_;
+};
@@ -0,0 +1,67 @@
+/*
+ * FS.h - files for the host build, on the host's own filesystem
+ *
+ * Paths are taken relative to the mounted root (see LittleFS.h).  A File
+ * is a cheap handle to shared state like on the ESP32, closing happens when
+ * the last copy goes away or close() is called.
+ */
+
+#pragma once
+
+#include <memory>
+#include "Arduino.h"
+
+namespace fs {
+
+struct FileImpl;
+
+class File : public Stream {
+public:
+	File() {}
+	File(std::shared_ptr<FileImpl> impl) : impl_(impl) {}
+
+	operator bool() const;
+	size_t write(uint8_t c) override { return write(&c, 1); }
+	size_t write(const uint8_t *buf, size_t len) override;
+	using Print::write;
+	int available() override;
+	int read() override;
+	size_t read(uint8_t *buf, size_t len);
+	void flush() override;
+	bool seek(uint32_t pos);
+	size_t position() const;
+	size_t size() const;
+	void close();
+	const char *path() const;
+	const char *name() const;
+	bool isDirectory() const;
+	File openNextFile(const char *mode = "r");
+
+private:
+	std::shared_ptr<FileImpl> impl_;
+};
+
+class FS {
+public:
+	File open(const char *path, const char *mode = "r", bool create = false);
+	File open(const String &path, const char *mode = "r", bool create = false)
+	{
+		return open(path.c_str(), mode, create);
+	}
+	bool exists(const char *path);
+	bool exists(const String &path) { return exists(path.c_str()); }
+	bool remove(const char *path);
+	bool remove(const String &path) { return remove(path.c_str()); }
+	bool rename(const char *from, const char *to);
+	bool mkdir(const char *path);
+	bool rmdir(const char *path);
+
+protected:
+	std::string hostPath(const char *path) const;
+	std::string root_;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
@@ -0,0 +1,38 @@
+/*
+ * HardwareSerial.h - UARTs for the host build
+ *
+ * UART 0 (Serial) is the console: stdout.  Any other UART is a
+ * pseudo-terminal, or the device named by ESP32_HOST_UART<n>, e.g. the
+ * slave side of an AVR128 emulator.  See esp32_host.h.
+ */
+
+#pragma once
+
+#include "Print.h"
+
+#define SERIAL_8N1 0x800001c
+
+class HardwareSerial : public Stream {
+public:
+	HardwareSerial(int uart) : uart_(uart) {}
+	void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rx = -1, int8_t tx = -1);
+	void end();
+	int available() override;
+	int read() override;
+	int peek() override;
+	size_t write(uint8_t c) override { return write(&c, 1); }
+	size_t write(const uint8_t *buf, size_t len) override;
+	using Print::write;
+	size_t setRxBufferSize(size_t size) { return size; }
+	operator bool() const { return fd_ >= 0 || uart_ == 0; }
+
+private:
+	bool fill();
+
+	int uart_;
+	int fd_ = -1;
+	uint8_t rx_[512];
+	size_t rxHead_ = 0, rxTail_ = 0;
+};
+
+extern HardwareSerial Serial;
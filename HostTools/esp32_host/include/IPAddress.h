@@ -0,0 +1,30 @@
+/*
+ * IPAddress.h - IPv4 address for the host build
+ *
+ * Stored the way the ESP32 core does: first octet in the low byte, so the
+ * uint32_t conversions match what the sketch saves in EEPROM on the device.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "Print.h"
+
+class IPAddress : public Printable {
+public:
+	IPAddress() : addr_(0) {}
+	IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+		: addr_(a | (uint32_t)b << 8 | (uint32_t)c << 16 | (uint32_t)d << 24) {}
+	IPAddress(uint32_t addr) : addr_(addr) {}
+
+	operator uint32_t() const { return addr_; }
+	uint8_t operator[](int i) const { return addr_ >> (8 * i); }
+	bool operator==(const IPAddress &o) const { return addr_ == o.addr_; }
+	bool operator!=(const IPAddress &o) const { return addr_ != o.addr_; }
+	String toString() const;
+	bool fromString(const char *s);
+	size_t printTo(Print &p) const override { return p.print(toString()); }
+
+private:
+	uint32_t addr_;
+};
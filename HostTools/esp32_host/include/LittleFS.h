@@ -0,0 +1,26 @@
+/*
+ * LittleFS.h - the flash partition for the host build, a directory
+ *
+ * begin() mounts ESP32_HOST_FS, creating it when formatOnFail is set.
+ * usedBytes() counts whole 4 KiB blocks per file like LittleFS does, plus
+ * the two superblocks, against a partition of ESP32_HOST_FS_SIZE.
+ */
+
+#pragma once
+
+#include "FS.h"
+
+class LittleFSFS : public fs::FS {
+public:
+	bool begin(bool formatOnFail = false, const char *basePath = "/littlefs",
+	           uint8_t maxOpenFiles = 10, const char *partitionLabel = "spiffs");
+	void end() { mounted_ = false; }
+	bool format();
+	size_t totalBytes();
+	size_t usedBytes();
+
+private:
+	bool mounted_ = false;
+};
+
+extern LittleFSFS LittleFS;
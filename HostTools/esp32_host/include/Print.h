@@ -0,0 +1,57 @@
+/*
+ * Print.h - Print and Stream for the host build
+ *
+ * Subclasses supply write(); everything else is built on it.
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "WString.h"
+
+class Print;
+
+/* Things that know how to print themselves, like IPAddress */
+class Printable {
+public:
+	virtual ~Printable() {}
+	virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+public:
+	virtual ~Print() {}
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t *buf, size_t len);
+	size_t write(const char *s);
+
+	size_t print(const char *s) { return write(s); }
+	size_t print(const String &s) { return write((const uint8_t *)s.c_str(), s.length()); }
+	size_t print(char c) { return write((uint8_t)c); }
+	size_t print(int v) { return print(String(v)); }
+	size_t print(unsigned int v) { return print(String(v)); }
+	size_t print(long v) { return print(String(v)); }
+	size_t print(unsigned long v) { return print(String(v)); }
+	size_t print(double v, int decimals = 2) { return print(String(v, decimals)); }
+	size_t print(const Printable &v) { return v.printTo(*this); }
+	size_t println(const Printable &v) { return print(v) + println(); }
+	template <class T> size_t println(T v) { return print(v) + println(); }
+	size_t println() { return write("\r\n"); }
+	size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+	virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() { return -1; }
+	size_t readBytes(uint8_t *buf, size_t len);
+	size_t readBytes(char *buf, size_t len) { return readBytes((uint8_t *)buf, len); }
+	void setTimeout(unsigned long ms) { timeout_ = ms; }
+
+protected:
+	unsigned long timeout_ = 1000;
+};
@@ -0,0 +1,60 @@
+/*
+ * WString.h - Arduino String for the host build, backed by std::string
+ *
+ * Only what the sketch uses.  Like the ESP32 core, a String is a value
+ * and copies freely.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+class String {
+public:
+	String(const char *s = "") : s_(s != NULL ? s : "") {}
+	String(const std::string &s) : s_(s) {}
+	String(char c) : s_(1, c) {}
+	String(int v) : s_(std::to_string(v)) {}
+	String(unsigned int v) : s_(std::to_string(v)) {}
+	String(long v) : s_(std::to_string(v)) {}
+	String(unsigned long v) : s_(std::to_string(v)) {}
+	String(long long v) : s_(std::to_string(v)) {}
+	String(unsigned long long v) : s_(std::to_string(v)) {}
+	String(double v, unsigned char decimals = 2);
+
+	String &operator+=(const String &o) { s_ += o.s_; return *this; }
+	String &operator+=(const char *o) { s_ += o; return *this; }
+	String &operator+=(char c) { s_ += c; return *this; }
+	friend String operator+(const String &a, const String &b) { return String(a.s_ + b.s_); }
+	friend String operator+(const String &a, const char *b) { return String(a.s_ + b); }
+	friend String operator+(const char *a, const String &b) { return String(a + b.s_); }
+
+	bool equals(const String &o) const { return s_ == o.s_; }
+	bool equals(const char *o) const { return s_ == o; }
+	bool operator==(const String &o) const { return s_ == o.s_; }
+	bool operator==(const char *o) const { return s_ == o; }
+	bool operator!=(const String &o) const { return s_ != o.s_; }
+	bool operator!=(const char *o) const { return s_ != o; }
+	bool operator<(const String &o) const { return s_ < o.s_; }
+
+	unsigned int length() const { return s_.size(); }
+	bool isEmpty() const { return s_.empty(); }
+	const char *c_str() const { return s_.c_str(); }
+	char charAt(unsigned int i) const { return i < s_.size() ? s_[i] : 0; }
+	char operator[](unsigned int i) const { return charAt(i); }
+	long toInt() const;
+	float toFloat() const;
+	int indexOf(char c, unsigned int from = 0) const;
+	int indexOf(const char *s, unsigned int from = 0) const;
+	String substring(unsigned int from) const;
+	String substring(unsigned int from, unsigned int to) const;
+	void toCharArray(char *out, unsigned int size) const;
+	void toLowerCase();
+	void trim();
+
+	const std::string &str() const { return s_; }
+
+private:
+	std::string s_;
+};
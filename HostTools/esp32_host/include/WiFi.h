@@ -0,0 +1,78 @@
+/*
+ * WiFi.h - station and access point for the host build
+ *
+ * There is no radio.  A station connect succeeds ESP32_HOST_WIFI_MS after
+ * begin() if the SSID is listed in ESP32_HOST_WIFI (or that file does not
+ * exist), otherwise status() goes to WL_NO_SSID_AVAIL.  Writing a new list
+ * while running drops a connection whose SSID disappears from it, which is
+ * how the reconnect logic is exercised.  The web server listens on every
+ * host address whatever mode is set.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+
+typedef enum {
+	WIFI_OFF = 0,
+	WIFI_STA = 1,
+	WIFI_AP = 2,
+	WIFI_AP_STA = 3
+} wifi_mode_t;
+
+typedef enum {
+	WL_IDLE_STATUS = 0,
+	WL_NO_SSID_AVAIL = 1,
+	WL_SCAN_COMPLETED = 2,
+	WL_CONNECTED = 3,
+	WL_CONNECT_FAILED = 4,
+	WL_CONNECTION_LOST = 5,
+	WL_DISCONNECTED = 6
+} wl_status_t;
+
+class WiFiClass {
+public:
+	bool mode(wifi_mode_t m);
+	bool mode(int m) { return mode((wifi_mode_t)m); }
+	wifi_mode_t getMode() const { return mode_; }
+	static void persistent(bool) {}
+	bool setAutoReconnect(bool) { return true; }
+
+	wl_status_t begin(const char *ssid, const char *password = NULL, int32_t channel = 0,
+	                  const uint8_t *bssid = NULL, bool connect = true);
+	bool config(IPAddress local, IPAddress gateway, IPAddress subnet,
+	            IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+	bool disconnect(bool wifioff = false, bool eraseap = false);
+	wl_status_t status();
+	bool isConnected() { return status() == WL_CONNECTED; }
+
+	IPAddress localIP();
+	IPAddress gatewayIP();
+	IPAddress subnetMask();
+	IPAddress dnsIP(uint8_t i = 0);
+	String macAddress() { return "24:0A:C4:00:00:01"; }
+	String SSID() { return ssid_; }
+	uint8_t *BSSID() { return bssid_; }
+	int32_t channel() { return channel_; }
+	int8_t RSSI() { return -55; }
+
+	bool softAP(const char *ssid, const char *password = NULL);
+	bool softAPConfig(IPAddress local, IPAddress gateway, IPAddress subnet);
+	bool softAPdisconnect(bool wifioff = false);
+	IPAddress softAPIP() { return apIp_; }
+
+private:
+	bool inRange(const char *ssid);
+
+	wifi_mode_t mode_ = WIFI_OFF;
+	wl_status_t status_ = WL_DISCONNECTED;
+	String ssid_;
+	unsigned long beginAt_ = 0;
+	unsigned long lastRangeCheck_ = 0;
+	uint8_t bssid_[6] = {0x24, 0x0A, 0xC4, 0x00, 0x00, 0x02};
+	int32_t channel_ = 6;
+	IPAddress staticIp_, staticGateway_, staticMask_, staticDns_;
+	IPAddress apIp_;
+};
+
+extern WiFiClass WiFi;
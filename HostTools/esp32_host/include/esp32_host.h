@@ -0,0 +1,23 @@
+/*
+ * esp32_host.h - where the host build keeps what the ESP32 keeps in hardware
+ *
+ * Everything is relative to the working directory unless overridden:
+ *
+ *   ESP32_HOST_UART<n>      device to use for UART n (default: a new pty,
+ *                           its slave name is printed and written to uart<n>.pty)
+ *   ESP32_HOST_HTTP_PORT    port the web server listens on (default 8080)
+ *   ESP32_HOST_EEPROM       EEPROM image (default eeprom.bin)
+ *   ESP32_HOST_FS           LittleFS root directory (default littlefs)
+ *   ESP32_HOST_FS_SIZE      LittleFS partition size in bytes (default 1441792)
+ *   ESP32_HOST_GPIO         directory of input pins, file <pin> holding 0 or 1
+ *                           (default gpio; a missing file reads LOW)
+ *   ESP32_HOST_WIFI         file listing the SSIDs in range, one per line
+ *                           (default wifi_networks; missing: every SSID is)
+ *   ESP32_HOST_WIFI_MS      how long a station connect takes (default 300)
+ */
+
+#pragma once
+
+const char *hostSetting(const char *name, const char *fallback);
+void hostStartClock(void);
+void hostSetCurrentCore(int core);   /* What xPortGetCoreID() reports on this thread */
@@ -0,0 +1,272 @@
+/*
+ * Arduino.cpp - time, GPIO and the FreeRTOS calls for the host build
+ */
+
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <deque>
+#include <vector>
+#include "Arduino.h"
+
+static struct timespec boot_time = { 0, 0 };
+static thread_local int current_core = ARDUINO_RUNNING_CORE;
+
+const char *hostSetting(const char *name, const char *fallback)
+{
+	const char *value = getenv(name);
+	return (value != NULL && *value != '\0') ? value : fallback;
+}
+
+void hostSetCurrentCore(int core)
+{
+	current_core = core;
+}
+
+static uint64_t elapsed_us(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (boot_time.tv_sec == 0 && boot_time.tv_nsec == 0)
+		boot_time = now;
+	return (uint64_t)(now.tv_sec - boot_time.tv_sec) * 1000000 +
+	       (now.tv_nsec - boot_time.tv_nsec) / 1000;
+}
+
+/* Called first thing in main() so millis() starts near 0 like after a reset */
+void hostStartClock(void)
+{
+	elapsed_us();
+}
+
+unsigned long millis(void)
+{
+	return (unsigned long)(elapsed_us() / 1000);
+}
+
+unsigned long micros(void)
+{
+	return (unsigned long)elapsed_us();
+}
+
+void delay(unsigned long ms)
+{
+	struct timespec ts = { (time_t)(ms / 1000), (long)(ms % 1000) * 1000000 };
+	while (nanosleep(&ts, &ts) < 0 && errno == EINTR)
+		;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+	struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+	while (nanosleep(&ts, &ts) < 0 && errno == EINTR)
+		;
+}
+
+void yield(void)
+{
+	sched_yield();
+}
+
+uint32_t esp_random(void)
+{
+	static unsigned int seed = (unsigned int)time(NULL);
+	return ((uint32_t)rand_r(&seed) << 16) ^ (uint32_t)rand_r(&seed);
+}
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+	size_t len = strlen(src);
+
+	if (size > 0) {
+		size_t n = len < size - 1 ? len : size - 1;
+		memcpy(dst, src, n);
+		dst[n] = '\0';
+	}
+	return len;
+}
+#endif
+
+/* ---GPIO--- */
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+}
+
+/* Inputs come from ESP32_HOST_GPIO/<pin>, so a test can flip them with echo */
+int digitalRead(uint8_t pin)
+{
+	char path[256];
+	char c = '0';
+
+	snprintf(path, sizeof(path), "%s/%u", hostSetting("ESP32_HOST_GPIO", "gpio"), pin);
+	FILE *f = fopen(path, "r");
+	if (f == NULL)
+		return LOW;
+	if (fread(&c, 1, 1, f) != 1)
+		c = '0';
+	fclose(f);
+	return c == '1' ? HIGH : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+}
+
+/* ---FreeRTOS--- */
+
+void portENTER_CRITICAL(portMUX_TYPE *mux)
+{
+	pthread_mutex_lock(&mux->mutex);
+}
+
+void portEXIT_CRITICAL(portMUX_TYPE *mux)
+{
+	pthread_mutex_unlock(&mux->mutex);
+}
+
+struct task_start {
+	TaskFunction_t fn;
+	void *arg;
+	int core;
+	char name[16];
+};
+
+static void *task_main(void *arg)
+{
+	struct task_start start = *(struct task_start *)arg;
+
+	delete (struct task_start *)arg;
+	current_core = start.core == tskNO_AFFINITY ? 0 : start.core;
+	pthread_setname_np(pthread_self(), start.name);
+	start.fn(start.arg);
+	return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+	struct task_start *start = new task_start;
+	pthread_t thread;
+
+	start->fn = fn;
+	start->arg = arg;
+	start->core = core;
+	snprintf(start->name, sizeof(start->name), "%s", name);
+	if (pthread_create(&thread, NULL, task_main, start) != 0) {
+		delete start;
+		return pdFAIL;
+	}
+	pthread_detach(thread);
+	if (handle != NULL)
+		*handle = (TaskHandle_t)thread;
+	return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle)
+{
+	return xTaskCreatePinnedToCore(fn, name, stack, arg, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+	delay(ticks * portTICK_PERIOD_MS);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+	return millis() / portTICK_PERIOD_MS;
+}
+
+BaseType_t xPortGetCoreID(void)
+{
+	return current_core;
+}
+
+struct host_queue {
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+	size_t length;
+	size_t itemSize;
+	std::deque<std::vector<uint8_t>> items;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+	struct host_queue *q = new host_queue;
+
+	pthread_mutex_init(&q->lock, NULL);
+	pthread_cond_init(&q->changed, NULL);
+	q->length = length;
+	q->itemSize = itemSize;
+	return q;
+}
+
+/* Wait on the queue's condition until pred() holds or wait ticks pass */
+template <class Pred> static bool queue_wait(struct host_queue *q, TickType_t wait, Pred pred)
+{
+	struct timespec deadline;
+
+	if (wait != portMAX_DELAY) {
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += wait / 1000;
+		deadline.tv_nsec += (long)(wait % 1000) * 1000000;
+		if (deadline.tv_nsec >= 1000000000) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000;
+		}
+	}
+	while (!pred()) {
+		if (wait == 0)
+			return false;
+		if (wait == portMAX_DELAY)
+			pthread_cond_wait(&q->changed, &q->lock);
+		else if (pthread_cond_timedwait(&q->changed, &q->lock, &deadline) == ETIMEDOUT)
+			return pred();
+	}
+	return true;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait)
+{
+	pthread_mutex_lock(&q->lock);
+	if (!queue_wait(q, wait, [q] { return q->items.size() < q->length; })) {
+		pthread_mutex_unlock(&q->lock);
+		return pdFALSE;
+	}
+	const uint8_t *p = (const uint8_t *)item;
+	q->items.emplace_back(p, p + q->itemSize);
+	pthread_cond_broadcast(&q->changed);
+	pthread_mutex_unlock(&q->lock);
+	return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait)
+{
+	pthread_mutex_lock(&q->lock);
+	if (!queue_wait(q, wait, [q] { return !q->items.empty(); })) {
+		pthread_mutex_unlock(&q->lock);
+		return pdFALSE;
+	}
+	memcpy(item, q->items.front().data(), q->itemSize);
+	q->items.pop_front();
+	pthread_cond_broadcast(&q->changed);
+	pthread_mutex_unlock(&q->lock);
+	return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+	pthread_mutex_lock(&q->lock);
+	UBaseType_t n = q->items.size();
+	pthread_mutex_unlock(&q->lock);
+	return n;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q)
+{
+	return q->length - uxQueueMessagesWaiting(q);
+}
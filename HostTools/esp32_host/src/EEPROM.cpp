@@ -0,0 +1,47 @@
+/*
+ * EEPROM.cpp - EEPROM image in a file for the host build
+ */
+
+#include "Arduino.h"
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
+
+bool EEPROMClass::begin(size_t size)
+{
+	data_.assign(size, 0);
+	FILE *f = fopen(hostSetting("ESP32_HOST_EEPROM", "eeprom.bin"), "rb");
+	if (f != NULL) {
+		size_t n = fread(data_.data(), 1, size, f);
+		(void)n; /* A shorter image leaves the rest zero */
+		fclose(f);
+	}
+	return true;
+}
+
+uint8_t EEPROMClass::read(int address) const
+{
+	return (address >= 0 && (size_t)address < data_.size()) ? data_[address] : 0;
+}
+
+void EEPROMClass::write(int address, uint8_t value)
+{
+	if (address >= 0 && (size_t)address < data_.size())
+		data_[address] = value;
+}
+
+bool EEPROMClass::commit()
+{
+	const char *path = hostSetting("ESP32_HOST_EEPROM", "eeprom.bin");
+	std::string tmp = std::string(path) + ".tmp";
+	FILE *f = fopen(tmp.c_str(), "wb");
+
+	if (f == NULL)
+		return false;
+	bool ok = fwrite(data_.data(), 1, data_.size(), f) == data_.size();
+	ok = (fclose(f) == 0) && ok;
+	if (ok)
+		ok = rename(tmp.c_str(), path) == 0; /* All or nothing, like the NVS commit */
+	commits_++;
+	return ok;
+}
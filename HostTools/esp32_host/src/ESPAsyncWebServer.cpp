@@ -0,0 +1,629 @@
+/*
+ * ESPAsyncWebServer.cpp - HTTP/1.1 and server-sent events over poll()
+ *
+ * The server thread owns every connection.  Other threads only reach a
+ * connection through AsyncEventSource::send(), which appends to its output
+ * under lock_ and wakes the thread through wakePipe_.  Handlers run on the
+ * server thread without the lock held, as they run on async_tcp's task on
+ * the ESP32, so a slow handler holds up every other client the same way.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "ESPAsyncWebServer.h"
+
+#define TCP_SEGMENT   1460           /* Most the filler is asked for at once */
+#define REQUEST_MAX   (16 * 1024)    /* Headers and body together */
+
+struct HostConnection {
+	int fd;
+	std::string in;
+	std::string out;                   /* Guarded by lock_ */
+	size_t sent = 0;                   /* Bytes of out already written */
+	AsyncWebServerResponse *response = NULL;   /* Chunked response still filling */
+	size_t index = 0;                  /* Body bytes the filler has produced */
+	bool closeAfter = false;           /* Close once out is written */
+	AsyncEventSourceClient *client = NULL;
+};
+
+static const char *status_text(int code)
+{
+	switch (code) {
+	case 200: return "OK";
+	case 204: return "No Content";
+	case 301: return "Moved Permanently";
+	case 302: return "Found";
+	case 304: return "Not Modified";
+	case 400: return "Bad Request";
+	case 404: return "Not Found";
+	case 405: return "Method Not Allowed";
+	case 413: return "Payload Too Large";
+	case 500: return "Internal Server Error";
+	case 503: return "Service Unavailable";
+	default:  return "";
+	}
+}
+
+static int hex_digit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+static std::string url_decode(const std::string &s)
+{
+	std::string out;
+
+	for (size_t i = 0; i < s.size(); i++) {
+		if (s[i] == '+') {
+			out += ' ';
+		} else if (s[i] == '%' && i + 2 < s.size() && hex_digit(s[i + 1]) >= 0 && hex_digit(s[i + 2]) >= 0) {
+			out += (char)(hex_digit(s[i + 1]) << 4 | hex_digit(s[i + 2]));
+			i += 2;
+		} else {
+			out += s[i];
+		}
+	}
+	return out;
+}
+
+/* "a=1&b=2" into args */
+static void parse_args(std::map<std::string, String> &args, const std::string &s)
+{
+	size_t pos = 0;
+
+	while (pos < s.size()) {
+		size_t amp = s.find('&', pos);
+		if (amp == std::string::npos)
+			amp = s.size();
+		std::string pair = s.substr(pos, amp - pos);
+		size_t eq = pair.find('=');
+		if (!pair.empty()) {
+			if (eq == std::string::npos)
+				args[url_decode(pair)] = String();
+			else
+				args[url_decode(pair.substr(0, eq))] = String(url_decode(pair.substr(eq + 1)).c_str());
+		}
+		pos = amp + 1;
+	}
+}
+
+/* ---Request--- */
+
+AsyncWebServerRequest::~AsyncWebServerRequest()
+{
+	for (AsyncWebHeader *h : headers_)
+		delete h;
+	delete response_;
+}
+
+const String &AsyncWebServerRequest::arg(const char *name) const
+{
+	static const String empty;
+	auto it = args_.find(name);
+	return it == args_.end() ? empty : it->second;
+}
+
+AsyncWebHeader *AsyncWebServerRequest::getHeader(const String &name) const
+{
+	for (AsyncWebHeader *h : headers_) {
+		if (strcasecmp(h->name().c_str(), name.c_str()) == 0)
+			return h;
+	}
+	return NULL;
+}
+
+void AsyncWebServerRequest::send(int code, const String &contentType, const String &content)
+{
+	send(beginResponse(code, contentType, content));
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse *response)
+{
+	if (response_ != NULL && response_ != response)
+		delete response_;
+	response_ = response;
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse(int code, const String &contentType,
+                                                             const String &content)
+{
+	AsyncWebServerResponse *response = new AsyncWebServerResponse();
+	response->code_ = code;
+	response->contentType_ = contentType;
+	response->body_.assign(content.c_str(), content.length());
+	return response;
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse_P(int code, const String &contentType,
+                                                               const uint8_t *content, size_t len)
+{
+	AsyncWebServerResponse *response = new AsyncWebServerResponse();
+	response->code_ = code;
+	response->contentType_ = contentType;
+	response->body_.assign((const char *)content, len);
+	return response;
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginChunkedResponse(const String &contentType,
+                                                                    AwsResponseFiller filler)
+{
+	AsyncWebServerResponse *response = new AsyncWebServerResponse();
+	response->contentType_ = contentType;
+	response->filler_ = filler;
+	return response;
+}
+
+AsyncResponseStream *AsyncWebServerRequest::beginResponseStream(const String &contentType, size_t bufferSize)
+{
+	AsyncResponseStream *response = new AsyncResponseStream();
+	response->contentType_ = contentType;
+	response->body_.reserve(bufferSize);
+	return response;
+}
+
+/* ---Server-sent events--- */
+
+static std::string event_text(const char *message, const char *event, uint32_t id, uint32_t reconnect)
+{
+	std::string text;
+	char number[16];
+
+	if (reconnect != 0) {
+		snprintf(number, sizeof(number), "%lu", (unsigned long)reconnect);
+		text += std::string("retry: ") + number + "\r\n";
+	}
+	if (id != 0) {
+		snprintf(number, sizeof(number), "%lu", (unsigned long)id);
+		text += std::string("id: ") + number + "\r\n";
+	}
+	if (event != NULL)
+		text += std::string("event: ") + event + "\r\n";
+	if (message != NULL) {
+		/* Every line of the message gets its own data: field */
+		const char *line = message;
+		for (;;) {
+			const char *end = strchr(line, '\n');
+			text += "data: ";
+			text.append(line, end == NULL ? strlen(line) : (size_t)(end - line));
+			text += "\r\n";
+			if (end == NULL)
+				break;
+			line = end + 1;
+		}
+	}
+	return text + "\r\n";
+}
+
+void AsyncEventSourceClient::send(const char *message, const char *event, uint32_t id, uint32_t reconnect)
+{
+	AsyncWebServer *server = source_->server_;
+
+	pthread_mutex_lock(&server->lock_);
+	if (connection_ != NULL) {
+		server->queueOutput(connection_, event_text(message, event, id, reconnect));
+		if (id != 0)
+			lastId_ = id;
+	}
+	pthread_mutex_unlock(&server->lock_);
+}
+
+void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect)
+{
+	if (server_ == NULL)
+		return;
+	std::string text = event_text(message, event, id, reconnect);
+
+	pthread_mutex_lock(&server_->lock_);
+	for (AsyncEventSourceClient *client : clients_) {
+		server_->queueOutput(client->connection_, text);
+		if (id != 0)
+			client->lastId_ = id;
+	}
+	pthread_mutex_unlock(&server_->lock_);
+}
+
+size_t AsyncEventSource::count() const
+{
+	if (server_ == NULL)
+		return 0;
+	pthread_mutex_lock(&server_->lock_);
+	size_t n = clients_.size();
+	pthread_mutex_unlock(&server_->lock_);
+	return n;
+}
+
+/* ---Server--- */
+
+AsyncWebServer::AsyncWebServer(uint16_t port) : port_(port)
+{
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&lock_, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+AsyncWebServer::~AsyncWebServer()
+{
+	end();
+}
+
+void AsyncWebServer::on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction handler)
+{
+	routes_.push_back(Route{uri, method, handler});
+}
+
+void AsyncWebServer::addHandler(AsyncWebHandler *handler)
+{
+	AsyncEventSource *source = dynamic_cast<AsyncEventSource *>(handler);
+
+	if (source != NULL) {
+		source->server_ = this;
+		sources_.push_back(source);
+	}
+}
+
+void AsyncWebServer::begin()
+{
+	struct sockaddr_in addr;
+	int one = 1;
+	/* The sketch asks for port 80, which needs root on the host */
+	uint16_t port = atoi(hostSetting("ESP32_HOST_HTTP_PORT", "8080"));
+
+	if (running_)
+		return;
+	listenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	if (bind(listenFd_, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listenFd_, 64) < 0) {
+		fprintf(stderr, "esp32_host: cannot listen on port %u (sketch asked for %u): %s\n",
+		        port, port_, strerror(errno));
+		close(listenFd_);
+		listenFd_ = -1;
+		return;
+	}
+	if (pipe2(wakePipe_, O_NONBLOCK | O_CLOEXEC) < 0) {
+		close(listenFd_);
+		listenFd_ = -1;
+		return;
+	}
+	fprintf(stderr, "esp32_host: web server on port %u (sketch asked for %u)\n", port, port_);
+	running_ = true;
+	pthread_create(&thread_, NULL, threadMain, this);
+}
+
+void AsyncWebServer::end()
+{
+	if (!running_)
+		return;
+	running_ = false;
+	wake();
+	pthread_join(thread_, NULL);
+	while (!connections_.empty())
+		closeConnection(connections_.back());
+	close(listenFd_);
+	close(wakePipe_[0]);
+	close(wakePipe_[1]);
+	listenFd_ = wakePipe_[0] = wakePipe_[1] = -1;
+}
+
+void *AsyncWebServer::threadMain(void *arg)
+{
+	hostSetCurrentCore(0); /* async_tcp runs on core 0 */
+	static_cast<AsyncWebServer *>(arg)->run();
+	return NULL;
+}
+
+void AsyncWebServer::wake()
+{
+	char c = 0;
+	ssize_t n = write(wakePipe_[1], &c, 1);
+	(void)n; /* Pipe already full means a wake up is pending anyway */
+}
+
+/* Caller holds lock_ */
+void AsyncWebServer::queueOutput(HostConnection *c, const std::string &data)
+{
+	bool idle = c->out.size() == c->sent;
+
+	c->out += data;
+	if (idle && pthread_self() != thread_)
+		wake();
+}
+
+void AsyncWebServer::closeConnection(HostConnection *c)
+{
+	pthread_mutex_lock(&lock_);
+	if (c->client != NULL) {
+		std::vector<AsyncEventSourceClient *> &clients = c->client->source_->clients_;
+		clients.erase(std::remove(clients.begin(), clients.end(), c->client), clients.end());
+		delete c->client;
+	}
+	connections_.erase(std::remove(connections_.begin(), connections_.end(), c), connections_.end());
+	pthread_mutex_unlock(&lock_);
+	close(c->fd);
+	delete c->response;
+	delete c;
+}
+
+void AsyncWebServer::run()
+{
+	std::vector<struct pollfd> fds;
+	std::vector<HostConnection *> polled;
+
+	while (running_) {
+		fds.clear();
+		polled.clear();
+		fds.push_back({listenFd_, POLLIN, 0});
+		fds.push_back({wakePipe_[0], POLLIN, 0});
+		pthread_mutex_lock(&lock_);
+		for (HostConnection *c : connections_) {
+			short events = POLLIN;
+			if (c->out.size() > c->sent || c->response != NULL)
+				events |= POLLOUT;
+			fds.push_back({c->fd, events, 0});
+			polled.push_back(c);
+		}
+		pthread_mutex_unlock(&lock_);
+
+		if (poll(fds.data(), fds.size(), -1) < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		if (fds[1].revents & POLLIN) {
+			char drain[64];
+			while (read(wakePipe_[0], drain, sizeof(drain)) > 0)
+				;
+		}
+		if (fds[0].revents & POLLIN) {
+			for (;;) {
+				int fd = accept4(listenFd_, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+				if (fd < 0)
+					break;
+				int one = 1;
+				setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+				HostConnection *c = new HostConnection();
+				c->fd = fd;
+				pthread_mutex_lock(&lock_);
+				connections_.push_back(c);
+				pthread_mutex_unlock(&lock_);
+			}
+		}
+
+		for (size_t i = 0; i < polled.size(); i++) {
+			HostConnection *c = polled[i];
+			short revents = fds[i + 2].revents;
+			bool closed = false;
+
+			if (revents & (POLLERR | POLLNVAL)) {
+				closeConnection(c);
+				continue;
+			}
+			if (revents & (POLLIN | POLLHUP)) {
+				char buf[4096];
+				ssize_t n = read(c->fd, buf, sizeof(buf));
+				if (n > 0) {
+					if (c->client == NULL && c->response == NULL && !c->closeAfter) {
+						c->in.append(buf, n);
+						handleReadable(c);
+					}
+				} else if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+					closed = true;
+				}
+			}
+			if (closed) {
+				closeConnection(c);
+				continue;
+			}
+			if (revents & POLLOUT) {
+				pthread_mutex_lock(&lock_);
+				if (c->out.size() == c->sent && c->response != NULL)
+					fillChunk(c);
+				ssize_t n = 0;
+				if (c->out.size() > c->sent)
+					n = send(c->fd, c->out.data() + c->sent, c->out.size() - c->sent, MSG_NOSIGNAL);
+				if (n > 0)
+					c->sent += n;
+				if (c->sent == c->out.size()) {
+					c->out.clear();
+					c->sent = 0;
+				}
+				bool done = c->closeAfter && c->out.empty() && c->response == NULL;
+				bool failed = n < 0 && errno != EAGAIN && errno != EINTR;
+				pthread_mutex_unlock(&lock_);
+				if (done || failed)
+					closeConnection(c);
+			}
+		}
+	}
+}
+
+void AsyncWebServer::handleReadable(HostConnection *c)
+{
+	if (c->in.size() > REQUEST_MAX) {
+		pthread_mutex_lock(&lock_);
+		queueOutput(c, "HTTP/1.1 413 Payload Too Large\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+		c->closeAfter = true;
+		pthread_mutex_unlock(&lock_);
+		return;
+	}
+	parseRequest(c);
+}
+
+/* False until a whole request has arrived */
+bool AsyncWebServer::parseRequest(HostConnection *c)
+{
+	size_t end = c->in.find("\r\n\r\n");
+	if (end == std::string::npos)
+		return false;
+
+	AsyncWebServerRequest *request = new AsyncWebServerRequest();
+	size_t lineEnd = c->in.find("\r\n");
+	std::string line = c->in.substr(0, lineEnd);
+	size_t contentLength = 0;
+
+	for (size_t pos = lineEnd + 2; pos < end;) {
+		size_t next = c->in.find("\r\n", pos);
+		std::string header = c->in.substr(pos, next - pos);
+		size_t colon = header.find(':');
+		if (colon != std::string::npos) {
+			std::string name = header.substr(0, colon);
+			size_t start = header.find_first_not_of(" \t", colon + 1);
+			std::string value = start == std::string::npos ? "" : header.substr(start);
+			request->headers_.push_back(new AsyncWebHeader(name.c_str(), value.c_str()));
+			if (strcasecmp(name.c_str(), "Content-Length") == 0)
+				contentLength = strtoul(value.c_str(), NULL, 10);
+		}
+		pos = next + 2;
+	}
+	if (c->in.size() < end + 4 + contentLength) {
+		delete request;
+		return false; /* Body still coming */
+	}
+
+	size_t sp1 = line.find(' ');
+	size_t sp2 = line.find(' ', sp1 + 1);
+	std::string method = line.substr(0, sp1);
+	std::string target = sp1 == std::string::npos ? "/" : line.substr(sp1 + 1, sp2 - sp1 - 1);
+	size_t query = target.find('?');
+
+	if (method == "POST")
+		request->method_ = HTTP_POST;
+	else if (method == "PUT")
+		request->method_ = HTTP_PUT;
+	else if (method == "DELETE")
+		request->method_ = HTTP_DELETE;
+	else if (method == "HEAD")
+		request->method_ = HTTP_HEAD;
+	else if (method == "OPTIONS")
+		request->method_ = HTTP_OPTIONS;
+	else if (method == "PATCH")
+		request->method_ = HTTP_PATCH;
+	else
+		request->method_ = HTTP_GET;
+	request->url_ = url_decode(target.substr(0, query)).c_str();
+	if (query != std::string::npos)
+		parse_args(request->args_, target.substr(query + 1));
+	AsyncWebHeader *type = request->getHeader("Content-Type");
+	if (contentLength > 0 && type != NULL &&
+	    strncasecmp(type->value().c_str(), "application/x-www-form-urlencoded", 33) == 0)
+		parse_args(request->args_, c->in.substr(end + 4, contentLength));
+	c->in.clear();
+
+	dispatch(c, request);
+	return true;
+}
+
+void AsyncWebServer::dispatch(HostConnection *c, AsyncWebServerRequest *request)
+{
+	for (AsyncEventSource *source : sources_) {
+		if (request->url_ != source->url_)
+			continue;
+		AsyncEventSourceClient *client = new AsyncEventSourceClient();
+		AsyncWebHeader *last = request->getHeader("Last-Event-ID");
+		client->source_ = source;
+		client->connection_ = c;
+		client->lastId_ = last != NULL ? strtoul(last->value().c_str(), NULL, 10) : 0;
+		pthread_mutex_lock(&lock_);
+		c->client = client;
+		queueOutput(c, "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+		               "Cache-Control: no-cache\r\nConnection: keep-alive\r\n\r\n");
+		source->clients_.push_back(client);
+		pthread_mutex_unlock(&lock_);
+		delete request;
+		if (source->onConnect_)
+			source->onConnect_(client);
+		return;
+	}
+
+	ArRequestHandlerFunction handler;
+	for (const Route &route : routes_) {
+		if (route.uri == request->url_.c_str() && (route.method & request->method_)) {
+			handler = route.handler;
+			break;
+		}
+	}
+	if (!handler)
+		handler = notFound_;
+	if (handler)
+		handler(request);
+	else
+		request->send(404, "text/plain", "Not found");
+	if (request->response_ == NULL)
+		request->send(500, "text/plain", "Handler sent no response");
+
+	AsyncWebServerResponse *response = request->response_;
+	request->response_ = NULL;
+	delete request;
+	queueResponse(c, response);
+}
+
+void AsyncWebServer::queueResponse(HostConnection *c, AsyncWebServerResponse *response)
+{
+	std::string head;
+	char line[128];
+
+	snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\n", response->code_, status_text(response->code_));
+	head += line;
+	if (response->contentType_.length() > 0)
+		head += std::string("Content-Type: ") + response->contentType_.c_str() + "\r\n";
+	for (const AsyncWebHeader &h : response->headers_)
+		head += std::string(h.name().c_str()) + ": " + h.value().c_str() + "\r\n";
+	if (response->filler_) {
+		head += "Transfer-Encoding: chunked\r\n";
+	} else {
+		snprintf(line, sizeof(line), "Content-Length: %zu\r\n", response->body_.size());
+		head += line;
+	}
+	head += "Connection: close\r\n\r\n";
+
+	pthread_mutex_lock(&lock_);
+	queueOutput(c, head);
+	if (response->filler_) {
+		c->response = response;
+		c->index = 0;
+	} else {
+		queueOutput(c, response->body_);
+		delete response;
+	}
+	c->closeAfter = true;
+	pthread_mutex_unlock(&lock_);
+}
+
+/* Caller holds lock_; the socket has room, ask the filler for one segment */
+void AsyncWebServer::fillChunk(HostConnection *c)
+{
+	uint8_t buffer[TCP_SEGMENT];
+	char size[16];
+	size_t n = c->response->filler_(buffer, sizeof(buffer), c->index);
+
+	if (n > sizeof(buffer))
+		n = 0; /* RESPONSE_TRY_AGAIN and nonsense both end it here */
+	snprintf(size, sizeof(size), "%zx\r\n", n);
+	c->out += size;
+	c->out.append((const char *)buffer, n);
+	c->out += "\r\n";
+	c->index += n;
+	if (n == 0) {
+		delete c->response;
+		c->response = NULL;
+	}
+}
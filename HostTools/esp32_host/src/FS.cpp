@@ -0,0 +1,285 @@
+/*
+ * FS.cpp - LittleFS on a host directory
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "LittleFS.h"
+
+LittleFSFS LittleFS;
+
+namespace fs {
+
+struct FileImpl {
+	FILE *fp = NULL;
+	std::string path;                   /* As the sketch named it, "/trips/00001.wmh" */
+	std::string host;                   /* Where it really is */
+	bool directory = false;
+	std::vector<std::string> entries;   /* Directory listing, taken at open */
+	size_t next = 0;
+	FS *fs = NULL;
+
+	~FileImpl()
+	{
+		if (fp != NULL)
+			fclose(fp);
+	}
+};
+
+File::operator bool() const
+{
+	return impl_ && (impl_->fp != NULL || impl_->directory);
+}
+
+size_t File::write(const uint8_t *buf, size_t len)
+{
+	if (!impl_ || impl_->fp == NULL)
+		return 0;
+	return fwrite(buf, 1, len, impl_->fp);
+}
+
+int File::available()
+{
+	if (!impl_ || impl_->fp == NULL)
+		return 0;
+	long pos = ftell(impl_->fp);
+	return pos < 0 ? 0 : (int)(size() - pos);
+}
+
+int File::read()
+{
+	if (!impl_ || impl_->fp == NULL)
+		return -1;
+	return fgetc(impl_->fp);
+}
+
+size_t File::read(uint8_t *buf, size_t len)
+{
+	if (!impl_ || impl_->fp == NULL)
+		return 0;
+	return fread(buf, 1, len, impl_->fp);
+}
+
+void File::flush()
+{
+	if (impl_ && impl_->fp != NULL) {
+		fflush(impl_->fp);
+		fsync(fileno(impl_->fp)); /* What the LittleFS sync costs on flash */
+	}
+}
+
+bool File::seek(uint32_t pos)
+{
+	return impl_ && impl_->fp != NULL && fseek(impl_->fp, pos, SEEK_SET) == 0;
+}
+
+size_t File::position() const
+{
+	if (!impl_ || impl_->fp == NULL)
+		return 0;
+	long pos = ftell(impl_->fp);
+	return pos < 0 ? 0 : pos;
+}
+
+size_t File::size() const
+{
+	struct stat st;
+
+	if (!impl_ || impl_->fp == NULL)
+		return 0;
+	fflush(impl_->fp); /* Count what is still buffered, the ESP32 does */
+	return fstat(fileno(impl_->fp), &st) == 0 ? st.st_size : 0;
+}
+
+void File::close()
+{
+	if (impl_ && impl_->fp != NULL) {
+		fclose(impl_->fp);
+		impl_->fp = NULL;
+	}
+	impl_.reset();
+}
+
+const char *File::path() const
+{
+	return impl_ ? impl_->path.c_str() : "";
+}
+
+const char *File::name() const
+{
+	if (!impl_)
+		return "";
+	size_t slash = impl_->path.rfind('/');
+	return impl_->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+bool File::isDirectory() const
+{
+	return impl_ && impl_->directory;
+}
+
+File File::openNextFile(const char *mode)
+{
+	if (!impl_ || !impl_->directory || impl_->next >= impl_->entries.size())
+		return File();
+	std::string child = impl_->path;
+	if (child.empty() || child.back() != '/')
+		child += '/';
+	child += impl_->entries[impl_->next++];
+	return impl_->fs->open(child.c_str(), mode);
+}
+
+std::string FS::hostPath(const char *path) const
+{
+	std::string host = root_;
+	if (path == NULL || path[0] != '/')
+		host += '/';
+	if (path != NULL)
+		host += path;
+	return host;
+}
+
+File FS::open(const char *path, const char *mode, bool create)
+{
+	std::shared_ptr<FileImpl> impl = std::make_shared<FileImpl>();
+	struct stat st;
+
+	if (root_.empty() || path == NULL)
+		return File();
+	impl->path = path;
+	impl->host = hostPath(path);
+	impl->fs = this;
+
+	if (stat(impl->host.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+		DIR *dir = opendir(impl->host.c_str());
+		if (dir == NULL)
+			return File();
+		for (struct dirent *e = readdir(dir); e != NULL; e = readdir(dir)) {
+			if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0)
+				impl->entries.push_back(e->d_name);
+		}
+		closedir(dir);
+		impl->directory = true;
+		return File(impl);
+	}
+
+	std::string m = mode;
+	if (m.find('b') == std::string::npos)
+		m += 'b';
+	impl->fp = fopen(impl->host.c_str(), m.c_str());
+	if (impl->fp == NULL)
+		return File();
+	return File(impl);
+}
+
+bool FS::exists(const char *path)
+{
+	struct stat st;
+	return !root_.empty() && stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path)
+{
+	return !root_.empty() && unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *from, const char *to)
+{
+	return !root_.empty() && ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path)
+{
+	return !root_.empty() && (::mkdir(hostPath(path).c_str(), 0777) == 0 || errno == EEXIST);
+}
+
+bool FS::rmdir(const char *path)
+{
+	return !root_.empty() && ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+} // namespace fs
+
+#define LITTLEFS_BLOCK 4096
+
+bool LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenFiles, const char *partitionLabel)
+{
+	const char *dir = hostSetting("ESP32_HOST_FS", "littlefs");
+	struct stat st;
+
+	if (stat(dir, &st) != 0 || !S_ISDIR(st.st_mode)) {
+		if (!formatOnFail || ::mkdir(dir, 0777) != 0)
+			return false;
+	}
+	root_ = dir;
+	mounted_ = true;
+	return true;
+}
+
+static void remove_tree(const std::string &path)
+{
+	DIR *dir = opendir(path.c_str());
+
+	if (dir == NULL)
+		return;
+	for (struct dirent *e = readdir(dir); e != NULL; e = readdir(dir)) {
+		if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0)
+			continue;
+		std::string child = path + "/" + e->d_name;
+		struct stat st;
+		if (stat(child.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+			remove_tree(child);
+			::rmdir(child.c_str());
+		} else {
+			unlink(child.c_str());
+		}
+	}
+	closedir(dir);
+}
+
+bool LittleFSFS::format()
+{
+	const char *dir = hostSetting("ESP32_HOST_FS", "littlefs");
+
+	remove_tree(dir);
+	return ::mkdir(dir, 0777) == 0 || errno == EEXIST;
+}
+
+size_t LittleFSFS::totalBytes()
+{
+	return strtoul(hostSetting("ESP32_HOST_FS_SIZE", "1441792"), NULL, 0);
+}
+
+static size_t blocks_used(const std::string &path)
+{
+	DIR *dir = opendir(path.c_str());
+	size_t blocks = 0;
+
+	if (dir == NULL)
+		return 0;
+	for (struct dirent *e = readdir(dir); e != NULL; e = readdir(dir)) {
+		if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0)
+			continue;
+		std::string child = path + "/" + e->d_name;
+		struct stat st;
+		if (stat(child.c_str(), &st) != 0)
+			continue;
+		if (S_ISDIR(st.st_mode))
+			blocks += 1 + blocks_used(child);
+		else
+			blocks += (st.st_size + LITTLEFS_BLOCK - 1) / LITTLEFS_BLOCK;
+	}
+	closedir(dir);
+	return blocks;
+}
+
+size_t LittleFSFS::usedBytes()
+{
+	if (!mounted_)
+		return 0;
+	return (2 + blocks_used(root_)) * LITTLEFS_BLOCK;
+}
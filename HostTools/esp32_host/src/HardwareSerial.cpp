@@ -0,0 +1,127 @@
+/*
+ * HardwareSerial.cpp - UART 0 on stdout, the others on pseudo-terminals
+ *
+ * A pty has no baud rate, bytes arrive as fast as the other end writes them.
+ * Reads never block: available() pulls whatever the kernel has into a small
+ * buffer, which stands in for the UART driver's RX ring.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include "Arduino.h"
+
+HardwareSerial Serial(0);
+
+static int open_pty(int uart)
+{
+	char setting[32];
+	char link[32];
+	struct termios tio;
+	const char *device;
+	int fd;
+
+	snprintf(setting, sizeof(setting), "ESP32_HOST_UART%d", uart);
+	device = hostSetting(setting, NULL);
+	if (device != NULL) {
+		fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+		if (fd < 0) {
+			fprintf(stderr, "esp32_host: UART%d: cannot open %s: %s\n", uart, device, strerror(errno));
+			return -1;
+		}
+	} else {
+		fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+		if (fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0) {
+			fprintf(stderr, "esp32_host: UART%d: no pty: %s\n", uart, strerror(errno));
+			if (fd >= 0)
+				close(fd);
+			return -1;
+		}
+		device = ptsname(fd);
+		fprintf(stderr, "esp32_host: UART%d is %s\n", uart, device);
+		snprintf(link, sizeof(link), "uart%d.pty", uart);
+		FILE *f = fopen(link, "w");
+		if (f != NULL) {
+			fprintf(f, "%s\n", device);
+			fclose(f);
+		}
+	}
+
+	if (tcgetattr(fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		tcsetattr(fd, TCSANOW, &tio);
+	}
+	return fd;
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rx, int8_t tx)
+{
+	if (uart_ == 0 || fd_ >= 0)
+		return;
+	fd_ = open_pty(uart_);
+}
+
+void HardwareSerial::end()
+{
+	if (fd_ >= 0)
+		close(fd_);
+	fd_ = -1;
+}
+
+bool HardwareSerial::fill()
+{
+	if (fd_ < 0)
+		return false;
+	if (rxHead_ == rxTail_)
+		rxHead_ = rxTail_ = 0;
+	if (rxTail_ < sizeof(rx_)) {
+		ssize_t n = ::read(fd_, rx_ + rxTail_, sizeof(rx_) - rxTail_);
+		if (n > 0)
+			rxTail_ += n;
+	}
+	return rxHead_ != rxTail_;
+}
+
+int HardwareSerial::available()
+{
+	fill();
+	return rxTail_ - rxHead_;
+}
+
+int HardwareSerial::read()
+{
+	if (rxHead_ == rxTail_ && !fill())
+		return -1;
+	return rx_[rxHead_++];
+}
+
+int HardwareSerial::peek()
+{
+	if (rxHead_ == rxTail_ && !fill())
+		return -1;
+	return rx_[rxHead_];
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t len)
+{
+	size_t done = 0;
+
+	if (uart_ == 0)
+		return fwrite(buf, 1, len, stdout);
+	if (fd_ < 0)
+		return 0;
+	while (done < len) {
+		ssize_t n = ::write(fd_, buf + done, len - done);
+		if (n > 0) {
+			done += n;
+		} else if (n < 0 && errno == EAGAIN) {
+			usleep(100); /* TX FIFO full, the device would block too */
+		} else if (n < 0 && errno == EIO) {
+			break; /* Nobody on the other end of the pty yet */
+		} else if (n < 0 && errno != EINTR) {
+			break;
+		}
+	}
+	return done;
+}
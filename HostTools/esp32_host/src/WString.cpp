@@ -0,0 +1,119 @@
+/*
+ * WString.cpp - String and Print for the host build
+ */
+
+#include "Arduino.h"
+
+String::String(double v, unsigned char decimals)
+{
+	char buf[64];
+	snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+	s_ = buf;
+}
+
+long String::toInt() const
+{
+	return strtol(s_.c_str(), NULL, 10);
+}
+
+float String::toFloat() const
+{
+	return strtof(s_.c_str(), NULL);
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+	size_t at = s_.find(c, from);
+	return at == std::string::npos ? -1 : (int)at;
+}
+
+int String::indexOf(const char *s, unsigned int from) const
+{
+	size_t at = s_.find(s, from);
+	return at == std::string::npos ? -1 : (int)at;
+}
+
+String String::substring(unsigned int from) const
+{
+	return from >= s_.size() ? String() : String(s_.substr(from));
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+	if (from > to)
+		std::swap(from, to);
+	if (from >= s_.size())
+		return String();
+	return String(s_.substr(from, to - from));
+}
+
+void String::toCharArray(char *out, unsigned int size) const
+{
+	if (size == 0)
+		return;
+	size_t n = std::min((size_t)size - 1, s_.size());
+	memcpy(out, s_.data(), n);
+	out[n] = '\0';
+}
+
+void String::toLowerCase()
+{
+	for (auto &c : s_)
+		c = tolower((unsigned char)c);
+}
+
+void String::trim()
+{
+	size_t start = s_.find_first_not_of(" \t\r\n");
+	size_t end = s_.find_last_not_of(" \t\r\n");
+	s_ = (start == std::string::npos) ? "" : s_.substr(start, end - start + 1);
+}
+
+size_t Print::write(const uint8_t *buf, size_t len)
+{
+	size_t n = 0;
+	while (n < len && write(buf[n]))
+		n++;
+	return n;
+}
+
+size_t Print::write(const char *s)
+{
+	return s == NULL ? 0 : write((const uint8_t *)s, strlen(s));
+}
+
+size_t Print::printf(const char *format, ...)
+{
+	char small[256];
+	va_list ap;
+
+	va_start(ap, format);
+	int n = vsnprintf(small, sizeof(small), format, ap);
+	va_end(ap);
+	if (n < 0)
+		return 0;
+	if ((size_t)n < sizeof(small))
+		return write((const uint8_t *)small, n);
+
+	std::string big(n + 1, '\0');
+	va_start(ap, format);
+	vsnprintf(&big[0], big.size(), format, ap);
+	va_end(ap);
+	return write((const uint8_t *)big.data(), n);
+}
+
+size_t Stream::readBytes(uint8_t *buf, size_t len)
+{
+	unsigned long start = millis();
+	size_t n = 0;
+
+	while (n < len && millis() - start < timeout_) {
+		int c = read();
+		if (c < 0) {
+			delay(1);
+			continue;
+		}
+		buf[n++] = c;
+	}
+	return n;
+}
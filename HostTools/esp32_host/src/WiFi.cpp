@@ -0,0 +1,146 @@
+/*
+ * WiFi.cpp - pretend station and access point for the host build
+ */
+
+#include <string>
+#include "WiFi.h"
+
+WiFiClass WiFi;
+
+String IPAddress::toString() const
+{
+	char buf[16];
+	snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+	return String(buf);
+}
+
+bool IPAddress::fromString(const char *s)
+{
+	unsigned int a, b, c, d;
+	char extra;
+
+	if (s == NULL || sscanf(s, "%u.%u.%u.%u%c", &a, &b, &c, &d, &extra) != 4 ||
+	    a > 255 || b > 255 || c > 255 || d > 255)
+		return false;
+	*this = IPAddress(a, b, c, d);
+	return true;
+}
+
+/* True if ssid is in the ESP32_HOST_WIFI list, or there is no list */
+bool WiFiClass::inRange(const char *ssid)
+{
+	FILE *f = fopen(hostSetting("ESP32_HOST_WIFI", "wifi_networks"), "r");
+	char line[64];
+	bool found = false;
+
+	if (f == NULL)
+		return true;
+	while (!found && fgets(line, sizeof(line), f) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		found = strcmp(line, ssid) == 0;
+	}
+	fclose(f);
+	return found;
+}
+
+bool WiFiClass::mode(wifi_mode_t m)
+{
+	mode_ = m;
+	if (!(m & WIFI_STA))
+		status_ = WL_DISCONNECTED;
+	return true;
+}
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *password, int32_t channel,
+                             const uint8_t *bssid, bool connect)
+{
+	if (!(mode_ & WIFI_STA))
+		mode_ = (wifi_mode_t)(mode_ | WIFI_STA);
+	ssid_ = ssid != NULL ? ssid : "";
+	beginAt_ = millis();
+	status_ = WL_IDLE_STATUS;
+	if (channel > 0)
+		channel_ = channel;
+	return status_;
+}
+
+bool WiFiClass::config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2)
+{
+	staticIp_ = local;
+	staticGateway_ = gateway;
+	staticMask_ = subnet;
+	staticDns_ = dns1;
+	return true;
+}
+
+bool WiFiClass::disconnect(bool wifioff, bool eraseap)
+{
+	status_ = WL_DISCONNECTED;
+	ssid_ = "";
+	return true;
+}
+
+wl_status_t WiFiClass::status()
+{
+	unsigned long now = millis();
+
+	if (status_ == WL_IDLE_STATUS &&
+	    now - beginAt_ >= (unsigned long)atol(hostSetting("ESP32_HOST_WIFI_MS", "300"))) {
+		status_ = inRange(ssid_.c_str()) ? WL_CONNECTED : WL_NO_SSID_AVAIL;
+		lastRangeCheck_ = now;
+	} else if (status_ == WL_CONNECTED && now - lastRangeCheck_ >= 1000) {
+		lastRangeCheck_ = now; /* The network can go away while connected */
+		if (!inRange(ssid_.c_str()))
+			status_ = WL_CONNECTION_LOST;
+	}
+	return status_;
+}
+
+IPAddress WiFiClass::localIP()
+{
+	if (status_ != WL_CONNECTED)
+		return IPAddress();
+	return (uint32_t)staticIp_ != 0 ? staticIp_ : IPAddress(127, 0, 0, 1);
+}
+
+IPAddress WiFiClass::gatewayIP()
+{
+	if (status_ != WL_CONNECTED)
+		return IPAddress();
+	return (uint32_t)staticIp_ != 0 ? staticGateway_ : IPAddress(127, 0, 0, 1);
+}
+
+IPAddress WiFiClass::subnetMask()
+{
+	if (status_ != WL_CONNECTED)
+		return IPAddress();
+	return (uint32_t)staticIp_ != 0 ? staticMask_ : IPAddress(255, 0, 0, 0);
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t i)
+{
+	if (status_ != WL_CONNECTED || i != 0)
+		return IPAddress();
+	return (uint32_t)staticIp_ != 0 ? staticDns_ : IPAddress(127, 0, 0, 53);
+}
+
+bool WiFiClass::softAP(const char *ssid, const char *password)
+{
+	mode_ = (wifi_mode_t)(mode_ | WIFI_AP);
+	if ((uint32_t)apIp_ == 0)
+		apIp_ = IPAddress(192, 168, 4, 1);
+	return true;
+}
+
+bool WiFiClass::softAPConfig(IPAddress local, IPAddress gateway, IPAddress subnet)
+{
+	apIp_ = local;
+	return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool wifioff)
+{
+	mode_ = (wifi_mode_t)(mode_ & ~WIFI_AP);
+	apIp_ = IPAddress();
+	return true;
+}
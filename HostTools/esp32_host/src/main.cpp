@@ -0,0 +1,21 @@
+/*
+ * main.cpp - runs the sketch the way the arduino-esp32 core does
+ *
+ * setup() once, then loop() forever on the loopTask, which is core 1.
+ */
+
+#include <signal.h>
+#include "Arduino.h"
+
+int main(void)
+{
+	signal(SIGPIPE, SIG_IGN); /* A client that goes away is not fatal */
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	hostStartClock();
+	hostSetCurrentCore(ARDUINO_RUNNING_CORE);
+	setup();
+	for (;;) {
+		loop();
+		yield();
+	}
+}
@@ -0,0 +1,293 @@
+/*
+ * http_bench.c - concurrency benchmark for the ESP32 web server
+ *
+ * Opens N client connections at once, each sending GET requests back to back
+ * (asking for keep-alive unless -k 0), and reports the latency spread for
+ * every concurrency level asked for.  Default levels are 1, 4 and 16 clients.
+ * When the server closes the connection anyway (ESPAsyncWebServer does after
+ * every response) the run says so, and conn counts one per request.
+ *
+ *   cc -O2 -pthread -o http_bench http_bench.c
+ *   ./http_bench -h 192.168.0.80 -p 80 -u /readAll -n 200 -c 1,4,16
+ *
+ *   -h host       ESP32 address (default 192.168.0.80)
+ *   -p port       (default 80)
+ *   -u path       request path (default /readAll)
+ *   -n count      requests per client (default 100)
+ *   -c list       comma separated client counts (default 1,4,16)
+ *   -k 0|1        ask to keep the connection open between requests (default 1)
+ *   -t ms         give up on one request after this long (default 5000)
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_CLIENTS 256
+#define RESPONSE_BUF 8192
+
+static const char *host = "192.168.0.80";
+static int port = 80;
+static const char *path = "/readAll";
+static int requests_per_client = 100;
+static int keep_alive = 1;
+static int timeout_ms = 5000;
+static struct sockaddr_in server_addr;
+
+struct client {
+	pthread_t thread;
+	double *latency_ms;   /* One entry per finished request */
+	int done;
+	int errors;
+	int reconnects;
+	int closed;           /* Responses the server closed the connection after */
+};
+
+static pthread_barrier_t start_line;
+
+static double now_ms(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static int open_connection(void)
+{
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	int one = 1;
+	struct timeval tv;
+
+	if (fd < 0)
+		return -1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	tv.tv_sec = timeout_ms / 1000;
+	tv.tv_usec = (timeout_ms % 1000) * 1000;
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+	if (connect(fd, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/*
+ * Read one response.  Returns 1 if the connection can be used again,
+ * 0 if the server closed it (response still complete), -1 on error.
+ */
+static int read_response(int fd)
+{
+	char buf[RESPONSE_BUF];
+	size_t have = 0;
+	char *body;
+	long content_length = -1;
+	int server_closes = !keep_alive;
+
+	for (;;) {
+		ssize_t n = recv(fd, buf + have, sizeof(buf) - 1 - have, 0);
+		if (n <= 0)
+			return -1;
+		have += n;
+		buf[have] = '\0';
+		body = strstr(buf, "\r\n\r\n");
+		if (body != NULL)
+			break;
+		if (have >= sizeof(buf) - 1)
+			return -1;
+	}
+	body += 4;
+	if (strncmp(buf, "HTTP/1.", 7) != 0 || strncmp(buf + 9, "200", 3) != 0)
+		return -1;
+
+	for (char *line = strstr(buf, "\r\n") + 2; line < body - 2; line = strstr(line, "\r\n") + 2) {
+		if (strncasecmp(line, "Content-Length:", 15) == 0)
+			content_length = strtol(line + 15, NULL, 10);
+		else if (strncasecmp(line, "Connection:", 11) == 0 && strstr(line, "close") != NULL)
+			server_closes = 1;
+	}
+
+	if (content_length < 0) {
+		/* No length, the body runs to the end of the connection */
+		char drain[1024];
+		while (recv(fd, drain, sizeof(drain), 0) > 0)
+			;
+		return 0;
+	}
+
+	long body_have = (long)(buf + have - body);
+	while (body_have < content_length) {
+		char drain[1024];
+		size_t want = content_length - body_have;
+		ssize_t n = recv(fd, drain, want < sizeof(drain) ? want : sizeof(drain), 0);
+		if (n <= 0)
+			return -1;
+		body_have += n;
+	}
+	return server_closes ? 0 : 1;
+}
+
+static void *client_main(void *arg)
+{
+	struct client *c = arg;
+	char request[512];
+	int fd = -1;
+	int len = snprintf(request, sizeof(request),
+	                   "GET %s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\n\r\n",
+	                   path, host, keep_alive ? "keep-alive" : "close");
+
+	pthread_barrier_wait(&start_line);
+
+	for (int i = 0; i < requests_per_client; i++) {
+		double start = now_ms();
+		int result;
+
+		if (fd < 0) {
+			fd = open_connection();
+			if (fd < 0) {
+				c->errors++;
+				continue;
+			}
+			c->reconnects++;
+		}
+		if (send(fd, request, len, MSG_NOSIGNAL) != len) {
+			c->errors++;
+			close(fd);
+			fd = -1;
+			continue;
+		}
+		result = read_response(fd);
+		if (result < 0) {
+			c->errors++;
+			close(fd);
+			fd = -1;
+			continue;
+		}
+		c->latency_ms[c->done++] = now_ms() - start; /* Includes connecting when it had to */
+		if (result == 0) {
+			c->closed++;
+			close(fd);
+			fd = -1;
+		}
+	}
+	if (fd >= 0)
+		close(fd);
+	return NULL;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, int count, double p)
+{
+	int i = (int)(p / 100.0 * (count - 1) + 0.5);
+	return sorted[i];
+}
+
+static void run_level(int clients)
+{
+	struct client c[MAX_CLIENTS];
+	double *all;
+	int total = 0, errors = 0, reconnects = 0, closed = 0;
+	double start, elapsed;
+
+	memset(c, 0, sizeof(c));
+	pthread_barrier_init(&start_line, NULL, clients + 1);
+	for (int i = 0; i < clients; i++) {
+		c[i].latency_ms = calloc(requests_per_client, sizeof(double));
+		pthread_create(&c[i].thread, NULL, client_main, &c[i]);
+	}
+	pthread_barrier_wait(&start_line);
+	start = now_ms();
+	for (int i = 0; i < clients; i++)
+		pthread_join(c[i].thread, NULL);
+	elapsed = now_ms() - start;
+	pthread_barrier_destroy(&start_line);
+
+	all = calloc((size_t)clients * requests_per_client, sizeof(double));
+	for (int i = 0; i < clients; i++) {
+		memcpy(all + total, c[i].latency_ms, c[i].done * sizeof(double));
+		total += c[i].done;
+		errors += c[i].errors;
+		reconnects += c[i].reconnects;
+		closed += c[i].closed;
+		free(c[i].latency_ms);
+	}
+
+	if (total == 0) {
+		printf("%4d clients: no successful requests (%d errors)\n", clients, errors);
+	} else {
+		qsort(all, total, sizeof(double), compare_double);
+		printf("%4d clients: %6d ok %4d err %5d conn  %8.1f req/s  p50 %7.1f ms  p99 %7.1f ms  max %7.1f ms\n",
+		       clients, total, errors, reconnects, total / (elapsed / 1000.0),
+		       percentile(all, total, 50), percentile(all, total, 99), all[total - 1]);
+		if (keep_alive && closed > 0)
+			printf("              server refused keep-alive: closed the connection after %d of %d responses\n",
+			       closed, total);
+	}
+	free(all);
+}
+
+int main(int argc, char **argv)
+{
+	const char *levels = "1,4,16";
+	struct addrinfo hints, *res;
+	char list[128];
+	int opt;
+
+	while ((opt = getopt(argc, argv, "h:p:u:n:c:k:t:")) != -1) {
+		switch (opt) {
+		case 'h': host = optarg; break;
+		case 'p': port = atoi(optarg); break;
+		case 'u': path = optarg; break;
+		case 'n': requests_per_client = atoi(optarg); break;
+		case 'c': levels = optarg; break;
+		case 'k': keep_alive = atoi(optarg); break;
+		case 't': timeout_ms = atoi(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-h host] [-p port] [-u path] [-n requests] [-c 1,4,16] [-k 0|1] [-t ms]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (requests_per_client < 1)
+		requests_per_client = 1;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	if (getaddrinfo(host, NULL, &hints, &res) != 0) {
+		fprintf(stderr, "can't resolve %s\n", host);
+		return 1;
+	}
+	server_addr = *(struct sockaddr_in *)res->ai_addr;
+	server_addr.sin_port = htons(port);
+	freeaddrinfo(res);
+
+	printf("GET http://%s:%d%s, %d requests per client, keep-alive %s\n",
+	       host, port, path, requests_per_client, keep_alive ? "asked for" : "off");
+
+	snprintf(list, sizeof(list), "%s", levels);
+	for (char *tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ",")) {
+		int clients = atoi(tok);
+		if (clients < 1 || clients > MAX_CLIENTS) {
+			fprintf(stderr, "client count %s out of range (1..%d)\n", tok, MAX_CLIENTS);
+			continue;
+		}
+		run_level(clients);
+	}
+	return 0;
+}
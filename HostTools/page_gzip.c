@@ -0,0 +1,203 @@
+/*
+ * page_gzip.c - build the gzipped web pages the ESP32 serves from flash
+ *
+ * Reads the raw-literal page headers (index.h, config.h, credentials.h),
+ * minifies each page, gzips it and writes one header with a byte array,
+ * its length and a strong ETag per page.  Run it again whenever a page
+ * changes and commit the result with it:
+ *
+ *   cc -O2 -o page_gzip page_gzip.c -lz
+ *   ./page_gzip ../AjaxServerCode/pages_gz.h ../AjaxServerCode/index.h \
+ *       ../AjaxServerCode/config.h ../AjaxServerCode/credentials.h
+ *
+ * Each input must hold  const char NAME[] PROGMEM = R"=====( ... )=====";
+ * and produces NAME_gz[], NAME_gz_len and NAME_etag.
+ *
+ * The minifier is deliberately simple: it trims each line, drops blank
+ * lines, HTML comments, CSS/JS block comments and whole-line // comments,
+ * but keeps the line breaks so JavaScript semicolon insertion still works.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#define LITERAL_OPEN  "R\"=====("
+#define LITERAL_CLOSE ")=====\""
+
+static char *read_file(const char *path, size_t *len)
+{
+	FILE *f = fopen(path, "rb");
+	char *buf;
+	long size;
+
+	if (f == NULL)
+		return NULL;
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	buf = malloc(size + 1);
+	if (fread(buf, 1, size, f) != (size_t)size) {
+		fclose(f);
+		free(buf);
+		return NULL;
+	}
+	fclose(f);
+	buf[size] = '\0';
+	*len = size;
+	return buf;
+}
+
+/* Cut out the text between open and close, removing it from src */
+static void remove_between(char *src, const char *open, const char *close)
+{
+	char *start;
+
+	while ((start = strstr(src, open)) != NULL) {
+		char *end = strstr(start + strlen(open), close);
+		if (end == NULL)
+			break;
+		end += strlen(close);
+		memmove(start, end, strlen(end) + 1);
+	}
+}
+
+/* Minify in place, returns the new length */
+static size_t minify(char *page)
+{
+	char *out = page;
+	char *line = page;
+
+	remove_between(page, "<!--", "-->");
+	remove_between(page, "/*", "*/");
+
+	while (*line != '\0') {
+		char *end = strchr(line, '\n');
+		char *next = end ? end + 1 : line + strlen(line);
+		if (end == NULL)
+			end = next;
+
+		while (line < end && (*line == ' ' || *line == '\t' || *line == '\r'))
+			line++;
+		while (end > line && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+			end--;
+
+		if (end > line && !(end - line >= 2 && line[0] == '/' && line[1] == '/')) {
+			memmove(out, line, end - line);
+			out += end - line;
+			*out++ = '\n';
+		}
+		line = next;
+	}
+	*out = '\0';
+	return out - page;
+}
+
+static unsigned char *gzip(const char *in, size_t in_len, size_t *out_len)
+{
+	z_stream zs;
+	size_t cap = compressBound(in_len) + 64;
+	unsigned char *out = malloc(cap);
+
+	memset(&zs, 0, sizeof(zs));
+	/* 15 + 16 = gzip wrapper instead of zlib */
+	if (deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+		return NULL;
+	zs.next_in = (unsigned char *)in;
+	zs.avail_in = in_len;
+	zs.next_out = out;
+	zs.avail_out = cap;
+	if (deflate(&zs, Z_FINISH) != Z_STREAM_END) {
+		deflateEnd(&zs);
+		free(out);
+		return NULL;
+	}
+	*out_len = zs.total_out;
+	deflateEnd(&zs);
+	return out;
+}
+
+/* FNV-1a, only has to change when the page does */
+static uint32_t fnv1a(const unsigned char *p, size_t len)
+{
+	uint32_t h = 2166136261u;
+
+	while (len--) {
+		h ^= *p++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static int convert(FILE *out, const char *path)
+{
+	size_t len, gz_len, min_len;
+	char *src = read_file(path, &len);
+	char *decl, *open, *close, name[64];
+	unsigned char *gz;
+
+	if (src == NULL) {
+		fprintf(stderr, "%s: can't read\n", path);
+		return -1;
+	}
+
+	decl = strstr(src, "const char ");
+	open = strstr(src, LITERAL_OPEN);
+	close = open ? strstr(open, LITERAL_CLOSE) : NULL;
+	if (decl == NULL || open == NULL || close == NULL || sscanf(decl, "const char %63[A-Za-z0-9_]", name) != 1) {
+		fprintf(stderr, "%s: no R\"=====( page literal\n", path);
+		free(src);
+		return -1;
+	}
+
+	open += strlen(LITERAL_OPEN);
+	*close = '\0';
+	min_len = minify(open);
+	gz = gzip(open, min_len, &gz_len);
+	if (gz == NULL) {
+		fprintf(stderr, "%s: gzip failed\n", path);
+		free(src);
+		return -1;
+	}
+
+	fprintf(out, "// %s: %zu bytes, %zu minified, %zu gzipped\n", path, len, min_len, gz_len);
+	fprintf(out, "const uint8_t %s_gz[] PROGMEM = {", name);
+	for (size_t i = 0; i < gz_len; i++)
+		fprintf(out, "%s0x%02x,", (i % 16) ? " " : "\n  ", gz[i]);
+	fprintf(out, "\n};\n");
+	fprintf(out, "const size_t %s_gz_len = %zu;\n", name, gz_len);
+	fprintf(out, "const char %s_etag[] = \"\\\"%08x-%zx\\\"\";\n\n", name, fnv1a(gz, gz_len), gz_len);
+
+	fprintf(stderr, "%s: %s %zu -> %zu -> %zu bytes\n", path, name, len, min_len, gz_len);
+	free(gz);
+	free(src);
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	FILE *out;
+	int status = 0;
+
+	if (argc < 3) {
+		fprintf(stderr, "usage: %s out.h page.h [page.h ...]\n", argv[0]);
+		return 2;
+	}
+	out = fopen(argv[1], "w");
+	if (out == NULL) {
+		fprintf(stderr, "%s: can't write\n", argv[1]);
+		return 1;
+	}
+
+	fprintf(out, "// ===Gzipped web pages served from flash===\n");
+	fprintf(out, "// GENERATED by HostTools/page_gzip.c from the page headers, do not edit.\n");
+	fprintf(out, "// Re-run it whenever index.h, config.h or credentials.h changes.\n\n");
+	for (int i = 2; i < argc; i++) {
+		if (convert(out, argv[i]) != 0)
+			status = 1;
+	}
+	fclose(out);
+	return status;
+}
@@ -0,0 +1,734 @@
+/*
+ * soch_emu.c - the SOC head (SDT module) on a pseudo-terminal
+ *
+ * Speaks the ASCII protocol main_128_wSoCH_wTCoff_wRPGon_R3.c uses on
+ * USART2 (9600 8N1).  Every command is "60<cmd>." and a CR; the reply is
+ * the text the AVR128 stores in its SOCH response arrays:
+ *
+ *   60v.    " 60V 176.54V"          Get_SOC_Response(.., 'V')
+ *   60c.    " 60C +0012.3A"         Get_SOC_Response(.., 'A')
+ *   60g.    " 60G 98.7%"            Get_SOC_Response(.., '%')
+ *   60w.    " 60WH -04321.1WH"      Get_SOC_Response(.., 'W')
+ *   60se.   " 60SE 0"               verify_SOCH_online() reads 7 chars
+ *   60r.    " 60R"                  clears the Wh counter
+ *
+ * each followed by a CR, which the AVR128 throws away with its "clear
+ * spurious data" reads.  Get_SOC_Response() keeps the first five characters
+ * and then reads until the terminator with no timeout, so a reply that
+ * never brings its terminator hangs the AVR128; the fault modes below are
+ * there to exercise exactly that.
+ *
+ * The pack follows a profile, one of the built in ones or a script file:
+ *
+ *   # seconds  amps  [fault]        amps > 0 charges the pack
+ *   300        -45                  drive
+ *   20         0     offline        SDT module unplugged
+ *   900        +20                  charge, tapers by itself near full
+ *   5          +20   noterm         replies lose their terminator
+ *
+ * A fault is one of offline (no reply), slow (reply after -L ms), noterm
+ * (the reply stops short of its terminator) or garbage (noise mixed into
+ * the reply).  The script loops at its end.
+ *
+ * Every few seconds it prints the commands answered, the faults injected
+ * and the turnaround.  With -c it is the AVR128 instead: it runs the EVIM
+ * loop's polling sequence against a responder (this program, or the real
+ * SDT module through a USB serial adapter), with a timeout on every read,
+ * and reports the cycle time and each command's round trip.
+ *
+ *   cc -O2 -o soch_emu soch_emu.c -lm
+ *   ./soch_emu -p cycle -k 60         a drive and charge cycle a minute
+ *   ./soch_emu -p trip.txt -d /dev/pts/3
+ *   ./soch_emu -c vi -n 200 -d /dev/ttyUSB0
+ *
+ *   -d device     serial device or pty to use (default: a new pty)
+ *   -b baud       pace bytes like a UART at this rate, 0 = as fast as
+ *                 possible (default 9600)
+ *   -p profile    drive, charge, cycle (default), idle or a script file
+ *   -k factor     run the profile this many times faster (default 1)
+ *   -l ms         delay before every reply (default 1)
+ *   -j ms         up to this much more, picked at random (default 0)
+ *   -L ms         how late a "slow" reply is (default 250)
+ *   -f fault      fault for the whole run, on top of the script's
+ *   -x percent    chance of dropping each reply byte (default 0)
+ *   -g percent    chance of a garbage byte in front of each reply byte
+ *                 (default 0, or 5 while the garbage fault is on)
+ *   -s seconds    report interval, 0 = only at the end (default 5)
+ *   -S seed       random seed (default: the time)
+ *   -c mode       be the AVR128: full (v, c, g, w), vi (v, c) or sw (g, w)
+ *   -n count      client: polling cycles to run (default 100)
+ *   -t ms         client: give up on a reply after this long (default 100)
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REPLY_MAX       32      /* " 60WH -04321.1WH" and its CR is the longest */
+#define COMMAND_MAX     16
+#define STEPS_MAX       256     /* Profile script lines */
+#define CAPACITY_AH     100.0   /* Simulated pack */
+
+enum fault { F_NONE, F_OFFLINE, F_SLOW, F_NOTERM, F_GARBAGE, F_KINDS };
+static const char *fault_names[F_KINDS] = { "none", "offline", "slow", "noterm", "garbage" };
+
+static const char *device;
+static long baud = 9600;
+static const char *profile = "cycle";
+static double speed = 1;
+static double latency_ms = 1;
+static double jitter_ms;
+static double slow_ms = 250;
+static enum fault forced_fault = F_NONE;
+static double drop_percent;
+static double garbage_percent = -1;    /* -1: only while the garbage fault is on */
+static double report_s = 5;
+static const char *client_mode;
+static long client_count = 100;
+static double client_timeout_ms = 100;
+
+static int fd = -1;
+static volatile sig_atomic_t stop;
+
+static double now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static double uniform(void)
+{
+	return rand() / (RAND_MAX + 1.0);
+}
+
+static void on_signal(int sig)
+{
+	stop = 1;
+}
+
+static double byte_us(void)
+{
+	return baud > 0 ? 10e6 / baud : 0; /* 8N1: start, 8 data, stop */
+}
+
+/* ---Latency samples--- */
+
+struct samples {
+	double *us;
+	size_t count, size;
+};
+
+static void sample_add(struct samples *s, double us)
+{
+	if (s->count == s->size) {
+		s->size = s->size ? s->size * 2 : 1024;
+		s->us = realloc(s->us, s->size * sizeof(double));
+	}
+	s->us[s->count++] = us;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, size_t count, double p)
+{
+	size_t i = (size_t)(p / 100.0 * (count - 1) + 0.5);
+	return sorted[i];
+}
+
+/* "p50 1.2 ms  p99 3.4 ms  max 5.6 ms" of the samples, which get sorted */
+static void print_spread(struct samples *s)
+{
+	if (s->count == 0) {
+		printf("  no samples");
+		return;
+	}
+	qsort(s->us, s->count, sizeof(double), compare_double);
+	printf("  p50 %6.2f ms  p90 %6.2f ms  p99 %6.2f ms  max %6.2f ms",
+	       percentile(s->us, s->count, 50) / 1000, percentile(s->us, s->count, 90) / 1000,
+	       percentile(s->us, s->count, 99) / 1000, s->us[s->count - 1] / 1000);
+}
+
+/* ---Profile--- */
+
+struct step {
+	double seconds;
+	double amps;        /* NAN for the built in drive load */
+	enum fault fault;
+};
+
+static struct step steps[STEPS_MAX];
+static int step_count;
+static double profile_length;
+
+static enum fault fault_by_name(const char *name)
+{
+	for (int f = 0; f < F_KINDS; f++) {
+		if (strcmp(name, fault_names[f]) == 0)
+			return f;
+	}
+	return F_KINDS;
+}
+
+static void add_step(double seconds, double amps, enum fault fault)
+{
+	if (step_count < STEPS_MAX && seconds > 0) {
+		steps[step_count++] = (struct step){ seconds, amps, fault };
+		profile_length += seconds;
+	}
+}
+
+static int load_profile(const char *name)
+{
+	FILE *f;
+	char line[128];
+	int number = 0;
+
+	if (strcmp(name, "drive") == 0) {
+		add_step(600, NAN, F_NONE);
+	} else if (strcmp(name, "charge") == 0) {
+		add_step(3600, 20, F_NONE);
+	} else if (strcmp(name, "idle") == 0) {
+		add_step(60, -0.5, F_NONE);
+	} else if (strcmp(name, "cycle") == 0) {
+		add_step(360, NAN, F_NONE);
+		add_step(30, -0.5, F_NONE);
+		add_step(180, 20, F_NONE);
+		add_step(30, -0.5, F_NONE);
+	} else if ((f = fopen(name, "r")) != NULL) {
+		while (fgets(line, sizeof(line), f) != NULL) {
+			char fault[16] = "none";
+			double seconds, amps;
+			char *hash = strchr(line, '#');
+
+			number++;
+			if (hash != NULL)
+				*hash = '\0';
+			if (strspn(line, " \t\r\n") == strlen(line))
+				continue;
+			if (sscanf(line, "%lf %lf %15s", &seconds, &amps, fault) < 2 || fault_by_name(fault) == F_KINDS) {
+				fprintf(stderr, "%s:%d: want \"seconds amps [fault]\"\n", name, number);
+				fclose(f);
+				return -1;
+			}
+			add_step(seconds, amps, fault_by_name(fault));
+		}
+		fclose(f);
+	} else {
+		fprintf(stderr, "no profile %s (drive, charge, cycle, idle or a file)\n", name);
+		return -1;
+	}
+	if (step_count == 0) {
+		fprintf(stderr, "profile %s is empty\n", name);
+		return -1;
+	}
+	return 0;
+}
+
+/* Step the profile is in at t seconds */
+static const struct step *step_at(double t)
+{
+	double into = fmod(t, profile_length);
+
+	for (int i = 0; i < step_count; i++) {
+		if (into < steps[i].seconds)
+			return &steps[i];
+		into -= steps[i].seconds;
+	}
+	return &steps[step_count - 1];
+}
+
+/* ---The pack--- */
+
+struct pack {
+	double t;          /* Profile seconds */
+	double soc;        /* Percent */
+	double wh;         /* Counter since the last 60r. */
+	double current;    /* Amps, positive while charging */
+	double volts;
+	enum fault fault;
+};
+
+static struct pack pack = { .soc = 80, .wh = -4321.1, .volts = 176.54 };
+
+static void pack_step(double dt)
+{
+	const struct step *s = step_at(pack.t);
+
+	pack.t += dt;
+	if (isnan(s->amps))
+		pack.current = -(40 + 35 * sin(pack.t * 2 * M_PI / 23) + 15 * sin(pack.t * 2 * M_PI / 7));
+	else
+		pack.current = s->amps;
+	if (pack.current > 0 && pack.soc >= 95)
+		pack.current = fmin(pack.current, 4 * (100 - pack.soc)); /* Charger tapers */
+
+	pack.soc += pack.current * dt / 3600 / CAPACITY_AH * 100;
+	pack.soc = fmin(100, fmax(0, pack.soc));
+	pack.volts = 160 + 0.22 * pack.soc + 0.05 * pack.current;
+	pack.wh += pack.volts * pack.current * dt / 3600;
+	pack.wh = fmin(99999.9, fmax(-99999.9, pack.wh));
+}
+
+/* Bring the pack up to now, a profile second at a time at most */
+static void pack_update(double now)
+{
+	static double last;
+	double dt;
+
+	if (last == 0)
+		last = now;
+	dt = (now - last) / 1e6 * speed;
+	last = now;
+	while (dt > 0) {
+		double step = fmin(dt, 1.0);
+		pack_step(step);
+		dt -= step;
+	}
+	pack.fault = forced_fault != F_NONE ? forced_fault : step_at(pack.t)->fault;
+}
+
+/* ---Replies--- */
+
+static uint8_t reply[2 * REPLY_MAX];    /* One at a time, the AVR128 waits for each */
+static size_t reply_len, reply_sent;
+static double reply_due, reply_request_at, line_free_at;
+
+enum { C_V, C_C, C_G, C_W, C_SE, C_R, C_IGNORED, C_LOST, C_KINDS };
+static const char *command_names[C_KINDS] = { "v", "c", "g", "w", "se", "r", "ignored", "lost" };
+static unsigned long commands[C_KINDS], commands_total[C_KINDS];
+static unsigned long faults[F_KINDS], faults_total[F_KINDS];
+static unsigned long bytes_in, bytes_out, bytes_dropped, bytes_garbage;
+static struct samples turnaround, turnaround_total;
+
+static void queue_reply(const char *text, double at)
+{
+	size_t len = strlen(text);
+	double garbage = garbage_percent >= 0 ? garbage_percent : (pack.fault == F_GARBAGE ? 5 : 0);
+	double delay = latency_ms + uniform() * jitter_ms;
+
+	faults[pack.fault]++;
+	if (pack.fault == F_OFFLINE)
+		return;
+	if (pack.fault == F_SLOW)
+		delay += slow_ms;
+	if (pack.fault == F_NOTERM)
+		len = strcspn(text + 5, "VA%W") + 5; /* Stops just short of the terminator */
+
+	if (reply_sent < reply_len)
+		commands[C_LOST]++; /* Asked again before the last reply was out */
+	reply_len = 0;
+	reply_sent = 0;
+	reply_request_at = at;
+	reply_due = at + delay * 1000;
+	for (size_t i = 0; i < len && reply_len < sizeof(reply) - 1; i++) {
+		if (uniform() * 100 < garbage) {
+			reply[reply_len++] = (uint8_t)rand();
+			bytes_garbage++;
+		}
+		if (uniform() * 100 < drop_percent) {
+			bytes_dropped++;
+			continue;
+		}
+		reply[reply_len++] = text[i];
+	}
+}
+
+/* Write what the UART would have sent by now; returns microseconds until more is due */
+static double pump_output(double now)
+{
+	double start = reply_due > line_free_at ? reply_due : line_free_at;
+	size_t allowed;
+	ssize_t n;
+
+	if (reply_sent >= reply_len)
+		return -1;
+	if (now < start)
+		return start - now;
+	if (reply_sent == 0)
+		line_free_at = start;
+	allowed = reply_len - reply_sent;
+	if (baud > 0) {
+		size_t due = (size_t)((now - line_free_at) / byte_us()) + 1;
+		if (due < allowed)
+			allowed = due;
+	}
+	n = write(fd, reply + reply_sent, allowed);
+	if (n < 0)
+		return errno == EAGAIN || errno == EIO ? 1000 : -1;
+	reply_sent += n;
+	line_free_at += n * byte_us();
+	bytes_out += n;
+	if (reply_sent < reply_len)
+		return byte_us() > 0 ? byte_us() : 100;
+	sample_add(&turnaround, fmax(now, line_free_at) - reply_request_at);
+	return -1;
+}
+
+static void execute(const char *command, double at)
+{
+	char text[REPLY_MAX];
+
+	if (strncmp(command, "60", 2) != 0) {
+		commands[C_IGNORED]++; /* Another address on the bus */
+		return;
+	}
+	command += 2;
+	if (strcmp(command, "v.") == 0) {
+		snprintf(text, sizeof(text), " 60V %6.2fV\r", pack.volts);
+		commands[C_V]++;
+	} else if (strcmp(command, "c.") == 0) {
+		snprintf(text, sizeof(text), " 60C %+07.1fA\r", pack.current);
+		commands[C_C]++;
+	} else if (strcmp(command, "g.") == 0) {
+		snprintf(text, sizeof(text), " 60G %.1f%%\r", pack.soc);
+		commands[C_G]++;
+	} else if (strcmp(command, "w.") == 0) {
+		snprintf(text, sizeof(text), " 60WH %+08.1fWH\r", pack.wh);
+		commands[C_W]++;
+	} else if (strcmp(command, "se.") == 0) {
+		snprintf(text, sizeof(text), " 60SE 0\r");
+		commands[C_SE]++;
+	} else if (strcmp(command, "r.") == 0) {
+		pack.wh = 0;
+		snprintf(text, sizeof(text), " 60R\r");
+		commands[C_R]++;
+	} else {
+		commands[C_IGNORED]++;
+		return;
+	}
+	queue_reply(text, at);
+}
+
+/* ---Reports--- */
+
+static void report(double seconds, unsigned long *counts, unsigned long *fault_counts, struct samples *s)
+{
+	unsigned long answered = 0;
+
+	for (int k = C_V; k <= C_R; k++)
+		answered += counts[k];
+	printf("%7.1f s %6.1f/s  %5.1f%% %+6.1fA ", pack.t, seconds > 0 ? answered / seconds : 0.0,
+	       pack.soc, pack.current);
+	for (int k = 0; k < C_KINDS; k++) {
+		if (counts[k] > 0)
+			printf(" %s %lu", command_names[k], counts[k]);
+	}
+	for (int f = F_OFFLINE; f < F_KINDS; f++) {
+		if (fault_counts[f] > 0)
+			printf(" %s %lu", fault_names[f], fault_counts[f]);
+	}
+	print_spread(s);
+	printf("\n");
+}
+
+static void report_interval(double seconds)
+{
+	report(seconds, commands, faults, &turnaround);
+	for (int k = 0; k < C_KINDS; k++) {
+		commands_total[k] += commands[k];
+		commands[k] = 0;
+	}
+	for (int f = 0; f < F_KINDS; f++) {
+		faults_total[f] += faults[f];
+		faults[f] = 0;
+	}
+	for (size_t i = 0; i < turnaround.count; i++)
+		sample_add(&turnaround_total, turnaround.us[i]);
+	turnaround.count = 0;
+}
+
+/* ---Responder--- */
+
+static int run_responder(void)
+{
+	double start = now_us();
+	double last_report = start;
+	char command[COMMAND_MAX];
+	size_t command_len = 0;
+
+	printf("answering as the SOCH, %ld baud, profile %s (%.0f s) x%g, latency %.1f+%.1f ms\n",
+	       baud, profile, profile_length, speed, latency_ms, jitter_ms);
+
+	while (!stop) {
+		struct pollfd p = {fd, POLLIN, 0};
+		double now = now_us();
+		double wait = pump_output(now);
+		double next_report = report_s > 0 ? last_report + report_s * 1e6 - now : -1;
+		int timeout;
+
+		if (wait < 0 || (next_report >= 0 && next_report < wait))
+			wait = next_report;
+		timeout = wait < 0 ? 1000 : (int)(wait / 1000);
+		if (poll(&p, 1, timeout) < 0 && errno != EINTR)
+			break;
+
+		now = now_us();
+		pack_update(now);
+		if (p.revents & POLLIN) {
+			uint8_t buf[64];
+			ssize_t n = read(fd, buf, sizeof(buf));
+			for (ssize_t i = 0; i < n; i++) {
+				bytes_in++;
+				if (buf[i] == '\r') {
+					command[command_len] = '\0';
+					execute(command, now);
+					command_len = 0;
+				} else if (buf[i] != '\n' && command_len < sizeof(command) - 1) {
+					command[command_len++] = buf[i];
+				}
+			}
+		} else if (p.revents & POLLHUP) {
+			usleep(10000); /* Other end of the pty not open (yet) */
+		}
+
+		if (report_s > 0 && now - last_report >= report_s * 1e6) {
+			report_interval((now - last_report) / 1e6);
+			last_report = now;
+		}
+	}
+
+	report_interval((now_us() - last_report) / 1e6);
+	printf("total:  ");
+	report((now_us() - start) / 1e6, commands_total, faults_total, &turnaround_total);
+	printf("bytes in %lu out %lu, dropped %lu, garbage %lu\n", bytes_in, bytes_out, bytes_dropped,
+	       bytes_garbage);
+	return 0;
+}
+
+/* ---Client: the AVR128's polling sequence--- */
+
+static void client_send(const char *text)
+{
+	size_t len = strlen(text);
+
+	for (size_t done = 0; done < len;) {
+		ssize_t n = write(fd, text + done, len - done);
+		if (n > 0)
+			done += n;
+		else if (n < 0 && errno != EAGAIN && errno != EINTR)
+			return;
+		else
+			usleep(100);
+	}
+	if (baud > 0)
+		usleep((useconds_t)(len * byte_us()));
+}
+
+/*
+ * Get_SOC_Response() with a deadline: five characters, then up to and
+ * including the terminator.  want is how many characters make a reply
+ * when terminator is 0 (verify_SOCH_online() reads 7).
+ */
+static int client_read(char *out, size_t size, char terminator, size_t want)
+{
+	double deadline = now_us() + client_timeout_ms * 1000;
+	size_t have = 0;
+
+	while (have < size - 1) {
+		struct pollfd p = {fd, POLLIN, 0};
+		double now = now_us();
+		char c;
+
+		if (now >= deadline)
+			break;
+		if (poll(&p, 1, (int)((deadline - now) / 1000) + 1) <= 0 || read(fd, &c, 1) != 1)
+			continue;
+		out[have++] = c;
+		if (terminator != 0 && have > 5 && c == terminator) {
+			out[have] = '\0';
+			return 1;
+		}
+		if (terminator == 0 && have >= want) {
+			out[have] = '\0';
+			return 1;
+		}
+	}
+	out[have] = '\0';
+	return 0;
+}
+
+static int run_client(void)
+{
+	static const struct { const char *command; char terminator; int kind; } all[] = {
+		{ "60v.\r", 'V', C_V }, { "60c.\r", 'A', C_C }, { "60g.\r", '%', C_G }, { "60w.\r", 'W', C_W }
+	};
+	int first, last;
+	struct samples cycle = {0};
+	struct samples rtt[C_KINDS] = {{0}};
+	unsigned long timeouts[C_KINDS] = {0};
+	unsigned long offline = 0;
+	long cycles = 0;
+	char text[REPLY_MAX * 2];
+
+	if (strcmp(client_mode, "full") == 0) {
+		first = 0, last = 3;
+	} else if (strcmp(client_mode, "vi") == 0) {
+		first = 0, last = 1;
+	} else if (strcmp(client_mode, "sw") == 0) {
+		first = 2, last = 3;
+	} else {
+		fprintf(stderr, "unknown client mode %s (full, vi or sw)\n", client_mode);
+		return 2;
+	}
+	printf("polling as the AVR128: %ld cycles of 60se. then %s, %ld baud, timeout %.0f ms\n",
+	       client_count, client_mode, baud, client_timeout_ms);
+	tcflush(fd, TCIFLUSH);
+
+	for (; cycles < client_count && !stop; cycles++) {
+		double cycle_start = now_us();
+		double sent;
+
+		tcflush(fd, TCIFLUSH); /* The "clear spurious data" reads */
+		sent = now_us();
+		client_send("60se.\r");
+		if (!client_read(text, sizeof(text), 0, 7)) {
+			timeouts[C_SE]++;
+			offline++;
+			continue; /* soch_offline_flag, nothing else is asked */
+		}
+		sample_add(&rtt[C_SE], now_us() - sent);
+		usleep(10000);  /* "Wait for SOCH to be ready" */
+
+		for (int k = first; k <= last; k++) {
+			tcflush(fd, TCIFLUSH);
+			sent = now_us();
+			client_send(all[k].command);
+			if (client_read(text, sizeof(text), all[k].terminator, 0))
+				sample_add(&rtt[all[k].kind], now_us() - sent);
+			else
+				timeouts[all[k].kind]++; /* The AVR128 would still be waiting */
+			usleep(5000);
+		}
+		sample_add(&cycle, now_us() - cycle_start);
+	}
+
+	printf("%ld cycles, %lu with the SOCH offline\n", cycles, offline);
+	printf("cycle     ");
+	print_spread(&cycle);
+	printf("\n");
+	for (int k = 0; k <= C_SE; k++) {
+		char name[8];
+
+		if (rtt[k].count == 0 && timeouts[k] == 0)
+			continue;
+		snprintf(name, sizeof(name), "60%s.", command_names[k]);
+		printf("%-8s  %5lu timeouts", name, timeouts[k]);
+		print_spread(&rtt[k]);
+		printf("\n");
+	}
+	return cycle.count > 0 ? 0 : 1;
+}
+
+/* ---Setup--- */
+
+static speed_t baud_constant(long rate)
+{
+	switch (rate) {
+	case 9600:   return B9600;
+	case 19200:  return B19200;
+	case 38400:  return B38400;
+	case 57600:  return B57600;
+	case 115200: return B115200;
+	default:     return 0;
+	}
+}
+
+static int open_port(void)
+{
+	struct termios tio;
+	int keep;
+
+	if (device != NULL) {
+		fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+		if (fd < 0) {
+			fprintf(stderr, "can't open %s: %s\n", device, strerror(errno));
+			return -1;
+		}
+	} else {
+		fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+		if (fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0) {
+			perror("pty");
+			return -1;
+		}
+		/* Hold the slave open too, so the master doesn't hang up between clients */
+		keep = open(ptsname(fd), O_RDWR | O_NOCTTY);
+		if (keep >= 0 && tcgetattr(keep, &tio) == 0) {
+			cfmakeraw(&tio);
+			tcsetattr(keep, TCSANOW, &tio);
+		}
+		printf("SOCH end of the link: %s\n", ptsname(fd));
+	}
+
+	if (tcgetattr(fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		if (baud_constant(baud) != 0)
+			cfsetspeed(&tio, baud_constant(baud)); /* Matters for a real serial port only */
+		tcsetattr(fd, TCSANOW, &tio);
+	}
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned seed = (unsigned)time(NULL);
+	int opt;
+
+	while ((opt = getopt(argc, argv, "d:b:p:k:l:j:L:f:x:g:s:S:c:n:t:")) != -1) {
+		switch (opt) {
+		case 'd': device = optarg; break;
+		case 'b': baud = atol(optarg); break;
+		case 'p': profile = optarg; break;
+		case 'k': speed = atof(optarg); break;
+		case 'l': latency_ms = atof(optarg); break;
+		case 'j': jitter_ms = atof(optarg); break;
+		case 'L': slow_ms = atof(optarg); break;
+		case 'f':
+			forced_fault = fault_by_name(optarg);
+			if (forced_fault == F_KINDS) {
+				fprintf(stderr, "unknown fault %s (offline, slow, noterm or garbage)\n", optarg);
+				return 2;
+			}
+			break;
+		case 'x': drop_percent = atof(optarg); break;
+		case 'g': garbage_percent = atof(optarg); break;
+		case 's': report_s = atof(optarg); break;
+		case 'S': seed = (unsigned)strtoul(optarg, NULL, 0); break;
+		case 'c': client_mode = optarg; break;
+		case 'n': client_count = atol(optarg); break;
+		case 't': client_timeout_ms = atof(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-d device] [-b baud] [-p profile] [-k factor] [-l ms] [-j ms] [-L ms]\n"
+			                "          [-f fault] [-x %%] [-g %%] [-s s] [-S seed]\n"
+			                "       %s -c full|vi|sw [-d device] [-b baud] [-n cycles] [-t ms]\n",
+			        argv[0], argv[0]);
+			return 2;
+		}
+	}
+	if (speed <= 0)
+		speed = 1;
+	srand(seed);
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+
+	if (client_mode == NULL && load_profile(profile) < 0)
+		return 1;
+	if (open_port() < 0)
+		return 1;
+	return client_mode != NULL ? run_client() : run_responder();
+}
@@ -0,0 +1,37 @@
+/*****************************************************************
+* ADC.h
+*
+* Background ADC0 scanner.  Every 1 mS tick (TCB0 CAPT, routed through
+* the event system to ADC0 START) converts one channel, accumulating
+* ADC_ACCUM samples in hardware; the RESRDY interrupt stores the result
+* in adc_sample[] and selects the next channel.  The channels are
+* scanned grouped by reference, so VREF only changes twice a scan:
+*
+*    2.5V    PD0..PD5   NTC10K temperature sensors (get_temps())
+*    4.096V  PD6, PD7   Aux-12V and Accy 13.3V dividers
+*            PF2        Aux-5V divider
+*
+* The first ADC_REF_SETTLE conversions after a reference change are
+* thrown away (that is what the old second get_adc_ntc10k() read was
+* for).  A full scan takes about ADC_CHANNELS + 2 mS.  Readers never
+* wait: adc_sample_get() returns the latest result, as a 12 bit value
+* like a single conversion gave.
+*****************************************************************/
+
+// Channels, in scan order (index into adc_sample[])
+#define ADC_CH_MOTOR        0    // PD0  AIN0
+#define ADC_CH_CONTROLLER   1    // PD1  AIN1
+#define ADC_CH_DCDC         2    // PD2  AIN2
+#define ADC_CH_BBOX1        3    // PD3  AIN3
+#define ADC_CH_BBOX2        4    // PD4  AIN4
+#define ADC_CH_AMBIENT      5    // PD5  AIN5
+#define ADC_CH_A12V         6    // PD6  AIN6
+#define ADC_CH_ACCY133      7    // PD7  AIN7
+#define ADC_CH_A5V          8    // PF2  AIN18
+#define ADC_CHANNELS        9
+#define ADC_CH_FIRST_4V096  ADC_CH_A12V   // Channels from here on use 4.096V
+
+#define ADC_ACCUM           16   // Samples accumulated per conversion (ADC_SAMPNUM_ACC16_gc)
+#define ADC_ACCUM_SHIFT     4    //   log2 of that, back to 12 bits
+#define ADC_SAMPLEN         8    // Extra sample time, ADC clocks (NTC dividers are a few k)
+#define ADC_REF_SETTLE      1    // Conversions dropped after a VREF change
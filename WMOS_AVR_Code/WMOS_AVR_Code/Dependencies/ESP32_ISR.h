@@ -1 +1,69 @@
-// EMPTY FOR NOW
\ No newline at end of file
+/*****************************************************************
+* ESP32_ISR.h
+*
+* Binary frame format for the ESP32 remote link (USART5, 115200)
+*
+*    SYNC  LEN  SEQ  TYPE  PAYLOAD[LEN]  CRC_L  CRC_H
+*
+*    SYNC  = 0xA5 (an ASCII command never starts with it, so the old
+*            single letter commands still work alongside the frames)
+*    LEN   = payload bytes only
+*    SEQ   = picked by the ESP32, copied into the reply so it can match
+*            replies to requests
+*    TYPE  = request type; the reply uses TYPE | REMOTE_TYPE_REPLY
+*    CRC   = CRC-16/CCITT (poly 0x1021, start 0xFFFF) over LEN..PAYLOAD
+*
+*    Multi byte payload values are little-endian.  A frame with a bad
+*    CRC is dropped without a reply and the receiver goes back to hunting
+*    for the next SYNC byte.
+*****************************************************************/
+
+#define REMOTE_SYNC             0xA5
+#define REMOTE_MAX_PAYLOAD      32     // Largest payload either side accepts
+
+// USART5 buffering (ring sizes are powers of two, 256 at most)
+#define REMOTE_RX_RING_SIZE     64     // Raw bytes waiting for remote_service()
+#define REMOTE_TX_RING_SIZE     128    // Reply bytes waiting for the DRE interrupt
+#define REMOTE_CMD_QUEUE_LEN    4      // Complete commands waiting to be executed
+#define REMOTE_CMD_DATA         50     // ASCII command line with its '\0', or a payload
+
+// Frame types (ESP32 -> AVR128)
+#define REMOTE_TYPE_SNAPSHOT    0x01   // Reply: REMOTE_SNAPSHOT_LEN byte snapshot below
+#define REMOTE_TYPE_RELAY_CYCLE 0x02   // Reply: empty, then the relay is power cycled
+#define REMOTE_TYPE_OLED_LINK   0x03   // Reply: REMOTE_OLED_LINK_LEN bytes below
+#define REMOTE_TYPE_REPLY       0x80   // Or'ed into the request type for the reply
+#define REMOTE_TYPE_NAK         0x7F   // Reply to an unknown type, payload = that type
+
+// Snapshot payload (offsets in bytes)
+#define SNAP_PACK_VOLTAGE   0    // uint16  pack volts x100     (pack_voltage_array)
+#define SNAP_PACK_CURRENT   2    // int16   pack amps x10       (pack_current_array)
+#define SNAP_PACK_SOC       4    // uint16  SoC percent x10     (pack_soc_array)
+#define SNAP_PACK_KWH       6    // int32   pack Wh x10         (pack_kwh_array)
+#define SNAP_AUX5           10   // uint16  Aux-5V x100
+#define SNAP_AUX12          12   // uint16  Aux-12V x100
+#define SNAP_ACCY133        14   // uint16  Accy 13.3V battery x100
+#define SNAP_TEMPS          16   // int16 x 6  scaled_temps_array[5..0] (Motor first)
+#define SNAP_FLAGS          28   // uint8   REMOTE_FLAG_* bits
+#define REMOTE_SNAPSHOT_LEN 29
+
+// OLED link payload: uint32 baud per display, OLED1 first, as
+// oled_init() negotiated it (0 = the display never answered)
+#define REMOTE_OLED_LINK_LEN 12
+
+// State flag bits (also the <flags> field of the ASCII 'n' command)
+#define REMOTE_FLAG_SOCH_OFFLINE  0x01
+#define REMOTE_FLAG_PACK_VOLTAGE  0x02
+#define REMOTE_FLAG_PACK_SOC95    0x04
+#define REMOTE_FLAG_CHARGE_CYCLE  0x08
+#define REMOTE_FLAG_EVIM_STATE    0x10
+#define REMOTE_FLAG_DSP_MODE      0x20
+#define REMOTE_FLAG_TAILITE       0x40
+
+// Receive states for the binary frames
+#define REMOTE_RX_IDLE      0
+#define REMOTE_RX_LEN       1
+#define REMOTE_RX_SEQ       2
+#define REMOTE_RX_TYPE      3
+#define REMOTE_RX_PAYLOAD   4
+#define REMOTE_RX_CRC_L     5
+#define REMOTE_RX_CRC_H     6
@@ -20,9 +20,56 @@
 #define	 WHITE          0xFFFF
 
 
+// OLED DRIVER  (one queue per display, see OLED_InterfaceRoutines)
+// ***************************/
+#define  OLED1               0      // Left,   USART0
+#define  OLED2               1      // Middle, USART3
+#define  OLED3               2      // Right,  USART1
+#define  OLED_COUNT          3
+#define  OLED_ACK            0x06
+#define  OLED_NAK            0x15
+#define  OLED_TX_QUEUE       128    // Command bytes queued per display (power of 2)
+#define  OLED_CMD_QUEUE      16     // Commands queued per display (power of 2)
+#define  OLED_ACK_TIMEOUT_MS 500    // Longest a command (clear screen) takes to ACK
+
+// OLED SHADOW TEXT  (what each display shows, so unchanged text isn't resent)
+// ***************************/
+#define  OLED_SHADOW_FIELDS  20     // Text fields remembered per display
+#define  OLED_SHADOW_TEXT    10     // Longest text remembered
+#define  OLED_CHAR_W         6      // System font cell (5x7 plus gap), for
+#define  OLED_CHAR_H         8      //   working out which fields overlap
+#define  OLED_ALIVE_IDLE_MS  400    // Refresh a display idle this long
+
+// OLED BAUD NEGOTIATION  (oled_init(), see oled_baud_negotiate())
+// ***************************/
+#define  OLED_BAUD_BASE      77     // setbaud index of 38400, the power-up rate
+#define  OLED_BAUD_TRIES     2      // Entries in oled_baud_index[]
+#define  OLED_BAUD_CHECKS    8      // Round trips that must all come back
+#define  OLED_BAUD_WAIT_MS   100    // Longest wait for a round trip answer
+#define  OLED_BAUD_SET_MS    500    // Longest wait for the setbaud ACK (sent
+                                    //   at the new rate, ~100 mS later)
+// Goldelox rate for setbaud index i, and the USART BAUD value for it
+#define  OLED_BAUD_RATE(i)   (3000000UL / ((uint32_t)(i) + 1))
+#define  OLED_BAUD_REG(i)    ((uint16_t)((4UL * (F_CPU / 1000UL) * ((uint32_t)(i) + 1) + 1500UL) / 3000UL))
+
+
 
 // Function PROTOTYPES
 // =========================================================
+void oled_driver_init(void);
+void oled_poll(uint8_t n);
+uint8_t oled_busy(uint8_t n);
+void oled_wait_idle(uint8_t mask);
+void oled_send_command(uint8_t n, const uint16_t *array_ptr);
+void oled_putstring(uint8_t n, const uint8_t *array_ptr);
+void oled_putchars(uint8_t n, const uint8_t *chars, uint8_t count);
+void oled_putchar(uint8_t n, uint16_t c);
+void oled_setxt_position(uint8_t n, uint16_t xpos, uint16_t ypos);
+void oled_contrast_set(uint8_t n, uint8_t contrast);
+void oled_keep_alive(uint8_t n);
+void oled_baud_negotiate(uint8_t n);
+uint32_t oled_link_baud(uint8_t n);
+
 void putcharOLED1(uint16_t c);
 void putcharOLED2(uint16_t c);
 void putcharOLED3(uint16_t c);
@@ -113,6 +160,11 @@ const uint16_t oled_setxt_FG_colorWHT[3] = {2, 0xff7F, 0xffff};   // WHITE COLOR
 
 const uint16_t oled_baud_set[3] = {2, 0x000B, 0xcf};
 
+// Rates oled_baud_negotiate() tries, fastest first (3000000 / (index + 1)).
+// Nothing above 115200: at 8MHz three displays that fast would leave
+// little time between their RXC interrupts for everything else.
+const uint16_t oled_baud_index[OLED_BAUD_TRIES] = {25, 51};   // 115200, 57600
+
 //Static variable for decimal manipulation
 static uint16_t dig_cnt;
 static uint8_t sign;
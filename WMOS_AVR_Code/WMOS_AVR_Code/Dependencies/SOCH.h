@@ -0,0 +1,65 @@
+/*****************************************************************
+* SOCH.h
+*
+* Request/response engine for the SOC head (SDT module) on USART2,
+* 9600:8:N:1.  Each transaction sends one length prefixed command
+* (get_pack_voltage[] etc.) and collects the reply:
+*
+*    60se.  ->  7 chars, only checked for (soch_offline_flag)
+*    60v.   ->  " 60V 176.54V"       stored up to the 'V'
+*    60c.   ->  " 60C +0012.3A"      stored up to the 'A'
+*    60g.   ->  " 60G 98.7%"         stored up to the '%'
+*    60w.   ->  " 60WH -04321.1WH"   stored up to the second 'W'
+*
+* The terminator only counts after the first five chars, as in the
+* old Get_SOC_Response().  A reply is collected in its own buffer and
+* copied into the pack_*_array only once it is complete, so a late,
+* short or runaway reply never leaves half a value behind.
+*****************************************************************/
+
+// Transactions, in the order the engine runs them
+#define SOCH_VERIFY         0
+#define SOCH_VOLTAGE        1
+#define SOCH_CURRENT        2
+#define SOCH_SOC            3
+#define SOCH_KWH            4
+#define SOCH_TRANSACTIONS   5
+
+// Bits for soch_poll_pack() and soch_updated
+#define SOCH_Q_VOLTAGE      (1 << SOCH_VOLTAGE)
+#define SOCH_Q_CURRENT      (1 << SOCH_CURRENT)
+#define SOCH_Q_SOC          (1 << SOCH_SOC)
+#define SOCH_Q_KWH          (1 << SOCH_KWH)
+#define SOCH_Q_ALL          (SOCH_Q_VOLTAGE | SOCH_Q_CURRENT | SOCH_Q_SOC | SOCH_Q_KWH)
+
+// Engine states
+#define SOCH_ST_IDLE        0    // Nothing queued
+#define SOCH_ST_SEND        1    // DRE interrupt sending the command
+#define SOCH_ST_RECV        2    // RXC interrupt collecting the reply
+#define SOCH_ST_DONE        3    // Reply complete (or too long), waiting for soch_engine_poll()
+#define SOCH_ST_GAP         4    // Quiet time before the next command
+
+// Result of the last run of each transaction (soch_result[])
+#define SOCH_RESULT_NONE    0
+#define SOCH_RESULT_OK      1
+#define SOCH_RESULT_TIMEOUT 2
+#define SOCH_RESULT_OVERRUN 3    // No terminator within SOCH_RESPONSE_MAX chars
+#define SOCH_RESULT_SKIPPED 4    // Not sent, verify found the SOCH offline
+
+// Timing, ms.  Timeouts run from the start of the command, which takes
+// about 1 ms a char to send and as long again per reply char
+#define SOCH_RESPONSE_MAX       16   // Size of the pack_*_array buffers
+#define SOCH_VERIFY_CHARS       7    // Reply chars verify waits for
+#define SOCH_VERIFY_TIMEOUT_MS  30
+#define SOCH_REPLY_TIMEOUT_MS   60
+#define SOCH_VERIFY_GAP_MS      10   // "Wait for SOCH to be ready" after verify
+#define SOCH_GAP_MS             2    // Lets the reply's trailing "H"/CR arrive before the next command
+
+// Scheduler (soch_schedule_config()): how old each value may get, ms
+#define SOCH_PERIOD_VI_MS         200   // Pack-V and Pack-I while driving
+#define SOCH_PERIOD_SOC_MS        2000  // SoC and kWh while driving
+#define SOCH_PERIOD_VI_CHARGE_MS  1000  // While charging everything moves slowly
+#define SOCH_PERIOD_SOC_CHARGE_MS 5000
+#define SOCH_PERIOD_SHOWN_MS      500   // At most this for the values on OLED2
+#define SOCH_OFFLINE_AFTER        3     // Timeouts in a row before soch_offline_flag
+#define SOCH_OFFLINE_RETRY_MS     1000  // Verify this often while offline
@@ -0,0 +1,41 @@
+/*****************************************************************
+* Scheduler.h
+*
+* Cooperative task scheduler on the TCB0 1 mS tick (tick_ms).  Each
+* task is a plain void function in sched_task_fn[], run from
+* sched_run() once it is due:
+*
+*    sched_every(task, ms)   run now, then every ms (periodic)
+*    sched_after(task, ms)   run once, ms from now (one-shot; the task
+*                            may call sched_after() again to chain)
+*    sched_stop(task)        forget it
+*
+* sched_run() is called from each FSM loop.  sched_delay_ms() and
+* sched_wait() replace the long _delay_ms() waits: they keep calling
+* sched_run() until the time is up or the task is done, so the SOCH,
+* the ESP32 link and the rest carry on meanwhile.  Tasks never run
+* inside each other; a task that waits just waits.
+*****************************************************************/
+
+// Tasks (bit numbers in sched_active)
+#define SCHED_SOCH          0    // soch_engine_poll(), while USART2 is up
+#define SCHED_REMOTE        1    // remote_service(), always
+#define SCHED_SENSORS       2    // Aux voltages and temps for the ESP32 (ignition wait)
+#define SCHED_OLED_ALIVE    3    // OLED activity refresh (ignition wait, EVIM)
+#define SCHED_TONE          4    // Beep sequences (tone_beeps())
+#define SCHED_SERVO         5    // Pedal lock servo steps
+#define SCHED_WAIT_FLASH    6    // Flashing WAIT on OLED2 (contactor wait)
+#define SCHED_TASKS         7
+
+// Periods and delays, ms
+#define SCHED_SOCH_MS           1
+#define SCHED_REMOTE_MS         1
+#define SCHED_SENSORS_MS        250
+#define SCHED_OLED_ALIVE_MS     500
+#define TONE_GAP_MS             175   // Between the beeps of tone_beeps()
+#define SERVO_POWER_UP_MS       650   // Servo SSR on to first pulse  NEEDED!!  09222021
+#define WAIT_SHOWN_MS           150   // WAIT on screen before it is cleared
+#define WAIT_FIRST_CLEARED_MS   350   // Cleared before it is shown again  WAS 300 03132022
+#define WAIT_CLEARED_MS         400   //    same, after the first time  REQUIRED! was 300 03102022
+#define OLED_RESET_MS           15    // OLED reset pulse (>2 mS)
+#define OLED_BOOT_MS            2800  // Reset to first command: 2500 DID NOT WORK @ 8MHz
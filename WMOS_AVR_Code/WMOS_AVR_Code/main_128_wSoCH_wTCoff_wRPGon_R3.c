@@ -75,6 +75,78 @@
  *		   d) TCA0 set for longer timeout (~ 5 minutes).  Also, TCA0 
  *			  counter register is reset to zero with each new data request.
  *
+ * 16. Added the "dump all" remote command 'n' (send_telemetry_frame() in
+ *     ESP32_ISR_Remote_InterfaceRoutines.inc).  Returns pack-V/I/SoC/kWh,
+ *     the aux and accy voltages, all six temps and the state flags in one
+ *     checksummed line, so the ESP32 needs one turnaround instead of 13.
+ *
+ * 17. Added the binary frame link to the ESP32 (sync, length, sequence,
+ *     type, CRC-16; format in ESP32_ISR.h).  The snapshot frame carries
+ *     fixed point integers instead of sprintf'd text.  The ASCII commands
+ *     still work, and the 50 byte command buffer can no longer overrun.
+ *
+ * 18. USART5 (ESP32 link) is now interrupt driven both ways through RX
+ *     and TX rings.  The RX ISR only stores the byte; remote_service(),
+ *     called from the standby, ignition-wait, contactor-wait and EVIM
+ *     loops, parses and queues complete commands and executes them.  No
+ *     sprintf, reply or relay delay runs inside the interrupt any more.
+ *
+ * 19. SOCH reads no longer block.  Get_SOC_Response() waited forever for
+ *     a terminator and verify_SOCH_online() gave up after ~1 mS, less
+ *     than its seven reply chars take at 9600.  The engine in
+ *     SOCH_InterfaceRoutines.inc sends each command from the USART2 DRE
+ *     interrupt, collects the reply in the RXC interrupt with a per
+ *     command timeout (TCB0 1 mS tick) and copies it into the pack
+ *     array only when complete.  The EVIM and ignition-wait loops queue
+ *     a round and carry on; the OLED busy-waits keep the engine going.
+ * 20. SOCH values are refreshed by rate instead of by screen.  The EVIM
+ *     loop used to ask only for the pair on OLED2 (and only every 4th
+ *     pass while charging, i_soch), so the ESP32 got stale values for
+ *     the other pair.  The engine now keeps a period for each value
+ *     (SOCH.h: V-I 200 mS, SoC-kWh 2 S, slower while charging, 500 mS
+ *     at most for the pair on screen) and sends the most overdue one as
+ *     soon as the last reply is in.  Verify only runs at start and,
+ *     after 3 timeouts in a row, once a second until the SOCH answers.
+ * 21. Long waits no longer stall everything else.  Scheduler.h adds a
+ *     cooperative scheduler on the TCB0 tick: periodic and one-shot
+ *     tasks run from sched_run() in each FSM loop.  The SOCH engine,
+ *     ESP32 link, ignition-wait sensor reads and OLED refresh, beep
+ *     sequences, pedal servo steps and the flashing WAIT are tasks now,
+ *     and the remaining long delays (OLED boot, power sequencing)
+ *     are sched_delay_ms(), which keeps the tasks running.
+ * 22. One OLED driver for all three displays (oled[OLED1..3]) instead
+ *     of three copies busy-waiting on oledN_busy_flag.  Commands go in
+ *     a queue per display; the USART DRE interrupt sends them and the
+ *     RXC interrupt takes the ACK/NAK (and the reply words of putstr
+ *     and the text "set" commands) before starting the next, with a
+ *     500 mS timeout.  A screen load now queues on all three OLEDs at
+ *     once and returns; with interrupts off (RPG ISR) it is polled.
+ * 23. Multi-digit values (pack V/A/SoC/kWh, aux and 13.3V voltages,
+ *     temperatures) are built in a small buffer and sent with one
+ *     PUTSTRING (oled_putchars) instead of a PUTCHAR and ACK per char:
+ *     a 5 char reading is 8 bytes and one ACK rather than 20 and five.
+ * 24. Unchanged text is no longer resent.  The OLED driver keeps a
+ *     shadow of the text fields on each display (origin, attributes,
+ *     chars) and drops a write that matches; setxt_position is only
+ *     sent with text that changed.  Lines/rectangles/clear forget the
+ *     shadow.  A steady EVIM screen is down to the attribute commands,
+ *     so oled_alive_task() (now also run in EVIM) keeps the OLEDs
+ *     from timing out.
+ * 25. Text height/width/colour/bold commands are only recorded; the
+ *     driver sends the ones a display doesn't already have just before
+ *     text that really goes out, like the origin (24).  Per display
+ *     counters (oled[n].state_asked / state_sent) show the savings.
+ * 26. oled_init() moves each OLED from 38400 to the fastest rate that
+ *     passes 8 round trips (115200, then 57600), per display, falling
+ *     back to 38400 (oled_baud_negotiate).  The rates go to the ESP32
+ *     in the new OLED link frame (ESP32_ISR.h) and show in /stats.
+ * 27. ADC0 scans PD0..PD7 and PF2 in the background (ADC.h): the 1 mS
+ *     tick starts each conversion through the event system, 16
+ *     samples accumulated in hardware, grouped by reference (2.5V NTCs,
+ *     4.096V dividers).  get_temps() and the aux/13.3V voltage routines
+ *     read the sample table instead of reconfiguring ADC0/VREF and
+ *     waiting 1 mS per conversion (temps no longer read twice).
+ *
  *   -------------------------------------------------------------------
  *   Basic Comm Init Routine is for all 4 UARTs
  *
@@ -189,9 +261,12 @@ void load_evim_screen_lines (void);
 void load_tmparray_display (void);
 void load_accy_voltage_display_init(void);
 void oled_init (void);
+void oled_driver_init (void);
+uint32_t oled_link_baud (uint8_t n);
 void oled_set_def_text (void);
 
 void tone (void);
+void remote_service(void);
 
 void clr_all_text_areas (void);
 void ssc_oled_lines (void);
@@ -207,14 +282,24 @@ int16_t scale_temp_ntc10k ( int16_t adc_result_12bit);
 void get_133V_battery_voltage (void);
 void get_a12V_voltage (void);
 void get_a5V_voltage (void);
+void load_133V_battery_voltage (void);
+void load_a12V_voltage (void);
+void load_a5V_voltage (void);
+void adc_scan_start (void);
+void adc_scan_stop (void);
+uint16_t adc_sample_get (uint8_t ch);
 
 void scale_temps_array(void);
 
-//SOC RELATED...
-uint8_t USART2_RcvChr(void);
+//SOC RELATED...
 void USART2_SndChr(uint8_t c);
-void SOC_UART2_SndCmd (const uint8_t *array_ptr);
-void verify_SOCH_online(void);
+void SOC_UART2_SndCmd (const uint8_t *array_ptr);
+void soch_engine_init(void);
+void soch_engine_poll(void);
+void soch_engine_wait(void);
+void soch_poll_pack(uint8_t quantities);
+void soch_schedule_config(uint8_t charging, uint8_t shown);
+uint8_t soch_busy(void);
 
 void display_pack_current (void);
 void display_pack_volatage (void);
@@ -227,8 +312,25 @@ void lock_accel_pedal_slo(void);
 void pedal_lock_pwr_on(void);
 void pedal_lock_pwr_off(void);
 
-void TCA0_init(void);  // Startup routine
-void TCA0_stop (void);  // Stop routine
+void TCA0_init(void);  // Startup routine
+void TCA0_stop (void);  // Stop routine
+void TCB0_tick_init(void);  // 1 mS tick
+uint16_t tick_now(void);
+
+// SCHEDULER RELATED... (Scheduler.h)
+void sched_every(uint8_t task, uint16_t period_ms);
+void sched_after(uint8_t task, uint16_t delay_ms);
+void sched_stop(uint8_t task);
+uint8_t sched_pending(uint8_t task);
+void sched_run(void);
+void sched_delay_ms(uint16_t ms);
+void sched_wait(uint8_t task);
+void sensors_task(void);
+void oled_alive_task(void);
+void tone_beeps(uint8_t count);
+void tone_task(void);
+void servo_task(void);
+void wait_flash_task(void);
 
 
 
@@ -302,7 +404,7 @@ int16_t scaled_temps_array [6] = {0};   // current/last scaled temps in
 uint16_t current_accy_batt_voltage = 0;  //accy batt voltage
 		   
 // Global timer counter (Short and longer timeout for return to STANDBY
-uint16_t to_counter = 0;  //USART2 receive timeout ctr
+volatile uint16_t tick_ms = 0;  // 1 mS tick from TCB0 (wraps every ~65 secs)
 
 // General use GLOBAL variables
 uint8_t i;
@@ -340,15 +442,6 @@ int16_t scaled_temps_array [6];   // current/last scaled temps
 
 uint16_t current_accy_batt_voltage;  //accy batt voltage  
 
-//OLED BUSY & NAK FLAGS - Version 7 Addition for || processing 
-uint8_t oled1_busy_flag;  // When a '1', must wait for executing
-uint8_t oled2_busy_flag;  // command to end (which will reset
-uint8_t oled3_busy_flag;  // the flag back to '0'...
-
-uint8_t oled1_NAK_flag;   // When a '1', must wait for executing
-uint8_t oled2_NAK_flag;   // command to end (which will reset
-uint8_t oled3_NAK_flag;   // the flag back to '0'...
-
 // Required STATE and Status flags...
 uint8_t standby_state_active_flag;
 uint8_t evim_state_active_flag;
@@ -382,6 +475,27 @@ uint8_t pack_voltage_flag = 0; //if 1 == pck voltage at ~182 VDC & UP!
 uint8_t pack_soc95_flag = 0;   //if 1 == SoC >= 95%                         
 uint8_t soch_offline_flag = 0; // 1 = SOCH Off-line; 0 = SOCH online/ready
 
+
+
+////////////////////////////////////////
+////////////////////////////////////////
+////    Scheduler Include Routines
+////  ----------------------------------
+# include <Scheduler.h>
+# include <Scheduler_InterfaceRoutines.inc>
+////
+////////////////////////////////////////
+
+
+////////////////////////////////////////
+////////////////////////////////////////
+////    ADC Scanner Include Routines
+////  ----------------------------------
+# include <ADC.h>
+# include <ADC_InterfaceRoutines.inc>
+////
+////////////////////////////////////////
+
 	  
 
 /*********************************************************************
@@ -396,6 +510,31 @@ void tone (void)
 	 PORTB.OUTCLR = PIN5_bm;
  }
 
+
+/*********************************************************************
+ void tone_beeps (uint8_t count)
+   Description: First beep now, the rest TONE_GAP_MS apart from the
+                scheduler (SCHED_TONE), so the caller carries on
+********************************************************************/
+uint8_t tone_beeps_left = 0;
+
+void tone_beeps (uint8_t count)
+ {
+	tone();
+	tone_beeps_left = count - 1;
+	if (tone_beeps_left != 0) {
+		sched_after(SCHED_TONE, TONE_GAP_MS);
+	}
+ }
+
+void tone_task (void)
+ {
+	tone();
+	if (--tone_beeps_left != 0) {
+		sched_after(SCHED_TONE, TONE_GAP_MS);
+	}
+ }
+
 
 /***********************************************************************
 * USARTs_Init     
@@ -448,6 +587,9 @@ void USARTs_Init (void)
 	USART3.CTRLB |= USART_TXEN_bm;
 	USART3.CTRLB |= USART_RXEN_bm;
 	
+	oled_driver_init();   // USART0/1/3 interrupts
+	soch_engine_init();   // USART2 interrupts
+	sched_every(SCHED_SOCH, SCHED_SOCH_MS);
 	remoteInterface_Init();
 }
 
@@ -467,20 +609,6 @@ void USARTs_Init (void)
 //===========  STATE OF CHARGE (SOC) HEAD ROUTINES   ======================
 //=========================================================================
 
-/**********************************************************************
-USART2 RECEIVE CHARACTER ROUTINE [Data from SOC Head (SOCH)]
-**********************************************************************
-* uint8_t USART2_RcvChr2 (void);
-* Description:	Waits for: "RXCIF" to be set, and then returns...
-*				the "RXDATAL" byte/character...
-**********************************************************************/
-uint8_t USART2_RcvChr(void)
-{
-	while (!(USART2.STATUS & USART_RXCIF_bm)) {};
-	return (USART2.RXDATAL);
-}
-
-
 /**********************************************************************
 USART2 SENDS CHARS TO SOCH
 **********************************************************************
@@ -552,93 +680,16 @@ void SOC_UART2_SndCmd (const uint8_t *array_ptr)
 }
 
 
-/*********************************************************************
-* Get_SOC_Response (array_ptr, end_char);
-*
-* Description:
-* -----------
-*   Reads a response from the SOC head, including, V, I, SOC%, and kWh;  
-*   Stores response in array pointed to by array_ptr.
-***********************************************************************/
-void Get_SOC_Response (uint8_t *array_ptr, uint8_t EOS_char)
-{
-	uint8_t EOSCHR; // V = volts, A = current, % = SOC, W(H)= watts
-	uint8_t i;
-	uint8_t *ptr;  // pointer to strt of cmd string to send
-	uint8_t recv_char = 0;
-
-	ptr = array_ptr;  // load pointer for command string
-	EOSCHR = EOS_char;  //end of str char, == end of response
-	
-		
-	//clear pending chars - VERY NECESSARY   Why??? Not sure
-	recv_char = USART2.RXDATAL;  // clear spurious data !!!!!!!
-	recv_char = USART2.RXDATAL;  // clear spurious data !!
-	recv_char = USART2.RXDATAL;  // clear spurious data !!
-		
-	// get first FIVE response chars and STORE in buffer
-	for (i =0; i<5; i++) {
-		recv_char = USART2_RcvChr();  
-		*ptr++ = recv_char;   //store received response char
-		}
-	
-	recv_char = 0;  //
-	// get rest of response string == actual value in ASCII, with units!!
-	while ( EOSCHR != recv_char)
-	{
-		recv_char = USART2_RcvChr();  // get 1st/next char
-		*ptr++ = recv_char;   //store received response char
-		}
-}
-
-
-
-/*********************************************************************
-* verify_SOCH_online(void);
-*
-* Description:
-* -----------
-*   Sends a test command to the SOCH and checks for the response chars,
-*   WITH a timeout counter included... If response received, sets the
-*   "soch_offline_flag" to 0.
-*
-*   If no response is received from the SOCH in ~ 2mS, the
-*   soch_offline_flag is set to 1, and returns.
-*
-***********************************************************************/
-void verify_SOCH_online(void)
-{
-	uint8_t i;
-	uint8_t recv_char = 0;
-	
-	to_counter = 0;
-	//send command to verify SOCH is there...
-	SOC_UART2_SndCmd (&soch_verify_command[0]);
-	//SOC_UART2_SndCmd (&get_pack_voltage[0]);
-	recv_char = USART2.RXDATAL;  // clear spurious data !!!!!!!
-	recv_char = USART2.RXDATAL;  // clear spurious data !!!!!!!
-	recv_char = USART2.RXDATAL;  // clear spurious data !!!!!!!
-
-	// Wait for response, with timeout counter...
-	// get response chars and discard...
-	for (i=0; i<7; i++) {
-	  while ((!(USART2.STATUS & USART_RXCIF_bm)) && (to_counter < 0x123)) {
-		_delay_us(3);
-		to_counter++;
-		}
-	recv_char = USART2.RXDATAL;  // 
-	}
+////////////////////////////////////////
+////  SOCH TRANSACTION ENGINE (Replaces the blocking
+////  Get_SOC_Response and verify_SOCH_online)
+////  ----------------------------------
+# include <SOCH.h>
+#include <SOCH_InterfaceRoutines.inc>
+////////////////////////////////////////
 
-	if (to_counter >= 0x123) {
-		soch_offline_flag = 1;     // SOCH is ready
-		}
-	else {
-		soch_offline_flag = 0;  // SOCH is OFF LINE
-		}
-	}
 
 
-
 /*********************************************************************
 * display_pack_voltage (array_ptr, end_char);
 *
@@ -651,6 +702,8 @@ void display_pack_voltage (void)
 {
 	uint8_t string_char = '0', first_digit = 0;
 	const uint8_t *ptr;  // pointer to command to send
+	uint8_t text[16];    // digits, sent as one string
+	uint8_t len = 0;
 	
 	ptr = &pack_voltage_array[4];
 
@@ -665,33 +718,35 @@ void display_pack_voltage (void)
 		if ((string_char == '0') || (string_char == 0x56))
 		{ /*do nothing */ }  // leading 0... Discard
 		else if ((string_char >= '1') && (string_char <= '9')) {  
-			putcharOLED2(string_char);
+			text[len++] = string_char;
 			first_digit = 1;
 		}
 		else if (string_char == '.') {  // minus sign?
-			//putcharOLED2(' ');
-			putcharOLED2('0');
-			putcharOLED2(string_char); // display "."
+			text[len++] = '0';
+			text[len++] = string_char; // display "."
 			string_char = *ptr++;  // get 10ths digit
-			putcharOLED2(string_char); // display 10ths
-			putcharOLED2(' ');
+			text[len++] = string_char; // display 10ths
+			text[len++] = ' ';
 			first_digit = 1;
 		}
 	}
 
 	// send value chars, but only to the TENTHs of a volt.
 	// End of string is an 'V'
-	while (string_char != 'V') {
+	while ((string_char != 'V') && (len < sizeof(text))) {
 		string_char = *ptr++;  // get 1st/next char
 		if (string_char == '.') {  // just send "V"
 			ptr = ptr + 2; 
+			oled_putchars(OLED2, text, len);  // the digits
+			len = 0;
 			// Settings for 'V', last pass through outer loop
 			oled2_send_command(&oled_setxt_height[0]);
 			oled2_setxt_position (114,23);   //   was 115
 		}
 		else
-		putcharOLED2(string_char);  // output next digit
+		text[len++] = string_char;  // next digit
 	}									// (and 'V' at end!)
+	oled_putchars(OLED2, text, len);
 }
 
 
@@ -715,6 +770,7 @@ void display_pack_current (void)
 	uint8_t tens = 0;
 	uint8_t units = 0;
 	uint8_t tenths = 0;
+	uint8_t text[3];
 	
 	// Scan first portion of array for a minus "-" sign
 	ptr = &pack_current_array[0];
@@ -765,21 +821,24 @@ void display_pack_current (void)
 
 	if ((thousands == '0') && (hundreds == '0') && (tens == '0')) {
 		// Just units and tenths To display
-		putcharOLED2(units);
-		putcharOLED2('.');
-		putcharOLED2(tenths);
+		text[0] = units;
+		text[1] = '.';
+		text[2] = tenths;
+		oled_putchars(OLED2, text, 3);
 		}
 	else if ((thousands == '0') && (hundreds == '0')) {
 		// Just Tens, units to display (NO decimal point!)
-		putcharOLED2(' ');  // space for hundreds position
-		putcharOLED2(tens);
-		putcharOLED2(units);
+		text[0] = ' ';  // space for hundreds position
+		text[1] = tens;
+		text[2] = units;
+		oled_putchars(OLED2, text, 3);
 		}
 	else if (thousands == '0') {
 		// Then display hundreds, tens, and units (NO decimal point!)
-		putcharOLED2(hundreds);  // space for hundreds position
-		putcharOLED2(tens);
-		putcharOLED2(units);
+		text[0] = hundreds;
+		text[1] = tens;
+		text[2] = units;
+		oled_putchars(OLED2, text, 3);
 		}
 
 	// Send the 'A'
@@ -802,6 +861,9 @@ void display_pack_soc (void)
 	uint8_t string_char = '0', first_digit = 0;
 	const uint8_t *ptr;  // pointer to command to send
 	
+	uint8_t text[16];    // digits, sent as one string
+	uint8_t len = 0;
+	
 	ptr = &pack_soc_array[4];  // set to first digit of soc percentage
 
 	// OK, set up OLED2..
@@ -815,25 +877,28 @@ void display_pack_soc (void)
 		if (string_char == '0')
 		{ /*do nothing */ }  // leading 0... Discard
 		else if ((string_char >= '1') && (string_char <= '9')) {  
-			putcharOLED2(string_char);
+			text[len++] = string_char;
 			first_digit = 1;
 		}
 	}
 
 	// send value chars, but only to the TENTHs of a volt.
 	// End of string is '%'
-	while (string_char != '%') {
+	while ((string_char != '%') && (len < sizeof(text))) {
 		string_char = *ptr++;  // get 1st/next char
 		if (string_char == '.') { // snd it & the 10ths digit
 			string_char = *ptr++;  // get 10ths digit
+			oled_putchars(OLED2, text, len);  // the digits
+			len = 0;
 					
 			// Settings for '%', last pass through outer loop
 			oled2_send_command(&oled_setxt_height_med[0]);
 			oled2_setxt_position (52,59);  // % position
 		}
 		else
-		putcharOLED2(string_char);  // output next digit
+		text[len++] = string_char;  // next digit
 	}									// (and '%' at end!)
+	oled_putchars(OLED2, text, len);
 }
 
 
@@ -870,13 +935,8 @@ void display_pack_kwh (void)
 	oled2_send_command (&oled_setxt_width[0]);
 	oled2_setxt_position (114,55); // Loc for start of tenths digit
 
-	// send tenths digit
-	string_char = *ptr++;  // get kWh digit...
-	putcharOLED2(string_char);
-
-	// send hundredths digit
-	string_char = *ptr++;  // get kWh digit...
-	putcharOLED2(string_char);
+	// send tenths and hundredths digits
+	oled_putchars(OLED2, ptr, 2);
 	}
 
 
@@ -1143,6 +1203,66 @@ void reload_big_wait_mid_oled (void)
 }
 
 
+// --------------------------------------------------------------
+// WAIT_FLASH_TASK  (SCHED_WAIT_FLASH)
+// Description:
+//    Flashes the big "W A I T" with a beep: cleared after
+//    WAIT_SHOWN_MS, reloaded after WAIT_(FIRST_)CLEARED_MS.
+//    Once reloaded it stops when the front contactor closes
+//    (or the EVIM state is left).  Started with WAIT on screen.
+// --------------------------------------------------------------
+uint8_t wait_flash_cleared = 0;   // 1 = WAIT is off OLED2
+uint8_t wait_flash_count = 0;     // Times it has been cleared
+
+void wait_flash_task (void)
+{
+	if (wait_flash_cleared == 0) {
+		cli();
+		// clear WAIT...
+		oled2_send_command (&oled_setxt_width_wide4[0]);
+		oled2_setxt_position (18,12);  //position for BIG WAIT.
+		oled2_putstring (&ClrWait[0]);			
+		sei();
+		tone();
+
+		wait_flash_cleared = 1;
+		if (wait_flash_count++ == 0) {
+			sched_after(SCHED_WAIT_FLASH, WAIT_FIRST_CLEARED_MS);
+		}
+		else {
+			sched_after(SCHED_WAIT_FLASH, WAIT_CLEARED_MS);
+		}
+		return;
+	}
+
+	cli();
+	reload_big_wait_mid_oled ();
+	oled1_setxt_position (3,14);
+	oled3_setxt_position (3,14);
+	sei();
+	wait_flash_cleared = 0;
+
+	if (((PORTE.IN & PIN0_bm)==0) && (top_state_num==EVIM_STATE)) {
+		sched_after(SCHED_WAIT_FLASH, WAIT_SHOWN_MS);
+	}
+}
+
+
+// --------------------------------------------------------------
+// OLED_ALIVE_TASK  (SCHED_OLED_ALIVE)
+// Description:
+//    Resets the activity time-out of all OLEDs while nothing
+//    else is written to them (ignition wait loop, and EVIM,
+//    where unchanged values are no longer resent)
+// --------------------------------------------------------------
+void oled_alive_task (void)
+{
+	oled_keep_alive (OLED1);   // activity refresh
+	oled_keep_alive (OLED2);   // (required)
+	oled_keep_alive (OLED3);   // 
+}
+
+
 
 
 
@@ -1293,43 +1413,92 @@ void temp_low_tasks (void)
 /                         (start at 16 .. 70 = 54 steps * 25uS per step)
 */        
 
+// Pedal lock servo move, run a step at a time by servo_task() (SCHED_SERVO)
+uint8_t servo_locking = 0;   // 1 = rotating UP to locked, 0 = DOWN to unlocked
+uint8_t servo_step = 0;      // Next step (14..70), 0 = powering up, 71 = settling
+
+// Time from one step's pulse to the next, mS
+uint8_t servo_step_ms(uint8_t step)
+{
+	if (servo_locking) {
+		if (step<20) {
+			return 70; }
+		else if (step<28) {
+			return 65; }
+		else if (step<36) {
+			return 60; }
+		else if (step<42) {
+			return 55; }
+		else if (step<50) {
+			return 50; }
+		else if (step<60) {
+			return 45; }
+		return 50;
+	}
+	if (step<20) {
+		return 70; }
+	else if (step<25) {
+		return 65; }
+	else if (step<30) {
+		return 58; }
+	else if (step<40) {
+		return 50; }
+	else if (step<50) {
+		return 40; }
+	else if (step<60) {
+		return 45; }
+	return 50;
+}
+
+void servo_task(void)
+{
+	if (servo_step == 0) {
+		// Get current servo position (if reed sw = 0, unlocked!!)
+		PORTA_image = PORTA.IN;
+		if (((PORTA_image & PIN5_bm) != 0) == servo_locking) {
+			return;   // Already there
+		}
+		servo_step = 14;
+	}
+	if (servo_step >= 71) {
+		return;   // Settled, done
+	}
+
+	if (servo_locking) {
+		dly_val = (uint16_t) (25 * servo_step); // 16*25=400uS (Strting point)
+	}
+	else {
+		dly_val = (uint16_t) (25 * (84-servo_step));
+	}
+	PORTA.OUTSET = PIN7_bm;  //Start of pulse
+	_delay_us(dly_val);
+	PORTA.OUTCLR = PIN7_bm;  //end of 1st/nxt pulse
+
+	if (servo_step == 70) {   // Last one, then let it settle
+		sched_after(SCHED_SERVO, servo_step_ms(servo_step) + (servo_locking ? 10 : 30));
+	}
+	else {
+		sched_after(SCHED_SERVO, servo_step_ms(servo_step));
+	}
+	servo_step++;
+}
+
+// Both moves return once the servo is done; the scheduler runs the
+// other tasks in the meantime
 void lock_accel_pedal_slo(void) // Unlocked=400 to Locked=1750 STEPDED
 {
 	//Verify pedal lock servo power (SSR) is ON  == 1
 	pedal_lock_pwr_on();
 
-    // IMPORTANT...  DO NOT REMOVE
+	//Rotate UP to locked position [400uS to 1750 uS, in steps]
+	servo_locking = 1;
+	servo_step = 0;
+
+    // IMPORTANT...  DO NOT REMOVE (power up delay)
 	// ******************************
-	_delay_ms(650);     // NEEDED!!  09222021
-	 
-	// Get current servo position (if reed sw = 0, unlocked!!)
-	PORTA_image = PORTA.IN;
-	if ((PORTA_image & PIN5_bm) == 0) { // So currently UNLOCKED
-		//Rotate UP to locked position [400uS to 1750 uS, in steps]
-		for (i=14; i< 71; i++)  {
-			dly_val = (uint16_t) (25 * i); // 16*25=400uS (Strting point)
-			PORTA.OUTSET = PIN7_bm;  //Start of pulse
-			_delay_us(dly_val);
-			PORTA.OUTCLR = PIN7_bm;  //end of 1st/nxt pulse
-			if (i<20) {
-				_delay_us (70000);
-				}
-			else if (i<28) {
-				_delay_us (65000);
-				}
-			else if (i<36) {
-				_delay_us (60000); 	}
-			else if (i<42) {
-				_delay_us (55000); 	}
-			else if (i<50) {
-				_delay_us (50000); 	}
-			else if (i<60) {
-				_delay_us (45000); 	}
-			else {
-				_delay_us (50000); 	}
-			}	
-		_delay_ms(10);
-	}  // NOTE: Power to SERVO is ON for exit.
+	sched_after(SCHED_SERVO, SERVO_POWER_UP_MS);
+	sched_wait(SCHED_SERVO);
+	// NOTE: Power to SERVO is ON for exit.
 }
 
 // From Locked 1750uS to unlocked 400uS (25uS steps)
@@ -1339,37 +1508,13 @@ void unlock_accel_pedal_slo(void)
 	//Verify servo power is ON,  SVO-SSR == 1
 	pedal_lock_pwr_on();
 		
+	//Rotate DOWN = Pedal Released
+	servo_locking = 0;
+	servo_step = 0;
+
 	// Long Delay    DEFINITELY NEEEDED!!
-	_delay_ms(650);     // 09222021
-
-	// Check present position...	
-	PORTA_image = PORTA.IN;
-	if ((PORTA_image & PIN5_bm) != 0) {  // Then it is locked
-		//Rotate DOWN = Pedal Released
-		for (i=14; i<71; i++)  {
-			dly_val = (uint16_t) (25 * (84-i));
-			PORTA.OUTSET = PIN7_bm;  //Start of pulse
-			_delay_us(dly_val);
-			PORTA.OUTCLR = PIN7_bm;  //END of fist/next pulse
-			      //_delay_us ((uint16_t) (64000-dly_val));  
-			if (i<20) {
-				_delay_us (70000); 	}
-			else if (i<25) {
-				_delay_us (65000); 	}
-			else if (i<30) {
-				_delay_us (58000); 	}
-			else if (i<40) {
-				_delay_us (50000); 	}
-			else if (i<50) {
-				_delay_us (40000);	}
-			else if (i<60) {
-				_delay_us (45000); 	}
-			else {
-				_delay_us (50000);  }
-			}
-		_delay_ms(30);	
-	}	
-	
+	sched_after(SCHED_SERVO, SERVO_POWER_UP_MS);
+	sched_wait(SCHED_SERVO);
 }
 
 
@@ -1501,8 +1646,51 @@ void TCA0_stop (void)
  /* disable overflow interrupt */
  TCA0.SINGLE.INTCTRL = 0;
  
- timeout_counter = 0; // added 12/16
-}
+ timeout_counter = 0; // added 12/16
+}
+
+
+
+//***************************************************************************
+// TCB0_tick_init
+// -----------------
+// DESCRIPTION: Starts the 1 mS system tick (tick_ms), used for the SOCH
+//       timeouts and the task scheduler.  Runs from cold start on and is
+//       never stopped.
+//
+//  8 MHz clock, no prescaler, periodic interrupt mode
+//
+//  CCMP = 8000 - 1 == 1 mS per interrupt
+//
+//**************************************************************************
+void TCB0_tick_init(void)
+{
+ TCB0.CCMP = (F_CPU / 1000UL) - 1;
+ TCB0.CNT = 0;
+ TCB0.CTRLB = TCB_CNTMODE_INT_gc;      /* periodic interrupt */
+ TCB0.INTCTRL = TCB_CAPT_bm;
+ TCB0.CTRLA = TCB_CLKSEL_DIV1_gc | TCB_ENABLE_bm;
+}
+
+
+// Read the 16 bit tick_ms in one piece.  With interrupts off (the
+// cli() sections) or inside another ISR the tick ISR can't run, so count
+// its flag here; called at least once a mS that keeps tick_ms going
+uint16_t tick_now(void)
+{
+ uint16_t now;
+ uint8_t sreg = SREG;
+
+ cli();
+ if ((!(sreg & CPU_I_bm) || (CPUINT.STATUS & CPUINT_LVL0EX_bm)) &&
+     (TCB0.INTFLAGS & TCB_CAPT_bm)) {
+  TCB0.INTFLAGS = TCB_CAPT_bm;
+  tick_ms++;
+ }
+ now = tick_ms;
+ SREG = sreg;
+ return now;
+}
 
 
 
@@ -1527,6 +1715,27 @@ void TCA0_stop (void)
 //===============================================================================
 
 
+//****************************************************************
+// sensors_task (void)                     (SCHED_SENSORS)
+//
+// Description:	Loads the low voltage digits and the scaled temps
+//				into their global variables for the ESP32 (ignition
+//				wait loop, nothing on the OLEDs)
+//****************************************************************
+void sensors_task (void)
+  {
+	// Get and store the low voltage digits in global variable:
+	load_a5V_voltage();
+	load_a12V_voltage();
+	load_133V_battery_voltage();
+
+	// Get and store the current temperature "raw" values
+	// (Must be processed/scaled to get digit values) 
+	get_temps();    // Load all current temps into array				
+	scale_temps_array();
+  }
+
+
 //****************************************************************
 // load_133V_battery_voltage (void)                    AVR128DA48
 //
@@ -1538,40 +1747,14 @@ void load_133V_battery_voltage (void)
   {
 	uint16_t adc_result_int, multiplier, current_batt_voltage;
 	uint32_t product;   // 4 byte product
-	uint8_t adc_result_low; //unsigned byte variables.
             
 	uint16_t hundredths; 
 	uint16_t tenths;
 	uint16_t units;
     uint16_t tens;
  
-	// Set ADC Enable bit to 1...
-	ADC0_CTRLA = 0; //reset all bits...
-	ADC0_CTRLA |= (PIN7_bm | PIN0_bm);  // Run always = 1 & 
-										// Enable = 1
-	// Select PD7 = ADC7
-	ADC0_MUXPOS = 0x07;  // Selects channel6, which is accy batt voltage
-	 	 
-	// Set Vref == 4.096 volts, and is always on...
-	VREF_ADC0REF = VREF_ALWAYSON_bm | VREF_REFSEL1_bm ; 
-
-	// OPTIONAL NOISE REDUCING CODE...
-	  // Set ACCUM == 4 (four samples returned)	// OPTIONAL NOISE REDUCING CODE...
-	  // ADC0_CTRLB |= ADC_SAMPNUM_ACC8_gc;		// OPTIONAL NOISE REDUCING CODE...
-	
-	// Small delay .... ????
-	_delay_ms (1);
-	 
-	// START CONVERSION...
-	ADC0_COMMAND |= PIN0_bm;  // Start a conversion
-	                           // Bit-0 is CLRd when converion complete
-							 
-	// Wait for END-OF-CONVERSION (Bit-0 cleared)
-	while (ADC0_COMMAND & PIN0_bm) {};  // Bit-0 == 0 == EOC
-	 
-	//Conversion complete... Build result int, and return
-	adc_result_low = ADC0.RESL;   //get low byte, load high byte into TEMP
-	adc_result_int = (uint16_t) ((((ADC0.RESH) << 8) | adc_result_low) +30);
+	// Latest sample from the background scanner (ADC.h)
+	adc_result_int = adc_sample_get(ADC_CH_ACCY133) + 30;
 
 	multiplier = (uint16_t) 1000;
 	product = ((uint32_t)adc_result_int * (uint32_t)multiplier);
@@ -1584,9 +1767,6 @@ void load_133V_battery_voltage (void)
 	current_batt_voltage = current_batt_voltage - 110;  // Due to in car shift?!	
 	// -------------------------------------------
 	
-	// Disable ADC... Enable = 0... Res = reset state
-	ADC0_CTRLA = 0;  // Enable is bit 1 == 1
-	
 	// Convert to BCD digits for display (process & separate
 	// digits), and load global variables
 	current_batt_voltage = current_batt_voltage/10; // reduce mv to TENTHS of mV
@@ -1621,39 +1801,14 @@ void load_a12V_voltage (void)
   {
 	uint16_t adc_result_int, multiplier, current_batt_voltage;
 	uint32_t product;   // 4 byte product
-	uint8_t adc_result_low; //unsigned byte variables.
             
 	uint16_t hundredths; 
 	uint16_t tenths;
 	uint16_t units;
     uint16_t tens;
  
-	// Set ADC Enable bit to 1...
-	ADC0_CTRLA = 0; //reset all bits...
-	ADC0_CTRLA |= (PIN6_bm | PIN0_bm);  // Run always = 1 & 
-										// Enable = 1
-	// Select PD6 = ADC6
-	ADC0_MUXPOS = 0x06;  // Selects channe6, which is aux 12V voltage
-	 	 
-	// Set Vref == 4.096 volts, and is always on...
-	VREF_ADC0REF = VREF_ALWAYSON_bm | VREF_REFSEL1_bm ; 
-
-	// OPTIONAL NOISE REDUCING CODE...
-	// Set ACCUM == 4 (four samples returned)	// OPTIONAL NOISE REDUCING CODE...
-	// ADC0_CTRLB |= ADC_SAMPNUM_ACC8_gc;		// OPTIONAL NOISE REDUCING CODE...
-	
-	// Small delay .... ????
-	_delay_ms (1);
-	 
-	// START CONVERSION...
-	ADC0_COMMAND |= PIN0_bm;  // Start a conversion
-	                           // Bit-0 is CLRd when converion complete
-	// Wait for END-OF-CONVERSION (Bit-0 cleared)
-	while (ADC0_COMMAND & PIN0_bm) {};  // Bit-0 == 0 == EOC
-	 
-	//Conversion complete... Build result int, and return
-	adc_result_low = ADC0.RESL;   //get low byte, load high byte into TEMP
-	adc_result_int = (uint16_t) ((((ADC0.RESH) << 8) | adc_result_low) +30);
+	// Latest sample from the background scanner (ADC.h)
+	adc_result_int = adc_sample_get(ADC_CH_A12V) + 30;
 
 	multiplier = (uint16_t) 1000;
 	product = ((uint32_t)adc_result_int * (uint32_t)multiplier);
@@ -1664,12 +1819,6 @@ void load_a12V_voltage (void)
 	current_batt_voltage = current_batt_voltage + 200; // ~ 0.200 volts added
 	//////// OFFSET/Correction Adjustment...  
 	//////// OFFSET/Correction Adjustment...
-
-	// Disable ADC... Enable = 0... Res = reset state
-	ADC0_CTRLA = 0;  // Enable is bit 1 == 1
-
-	// OPTIONAL NOISE REDUCING CODE...
-    //// current_batt_voltage = current_batt_voltage >> 3;  // for ACCUM reduction
 	
 	//Convert to BCD digits for display 
 	current_batt_voltage = current_batt_voltage/10; // reduce mvs to 1/10s of mV
@@ -1705,39 +1854,13 @@ void load_a5V_voltage (void)
   {
 	uint16_t adc_result_int, multiplier, current_batt_voltage;
 	uint32_t product;   // 4 byte product
-	uint8_t adc_result_low; //unsigned byte variables.
             
 	uint16_t hundredths; 
 	uint16_t tenths;
 	uint16_t units;
  
-	// Set ADC Enable bit to 1...
-	ADC0_CTRLA = 0; //reset all bits...
-	ADC0_CTRLA |= (PIN6_bm | PIN0_bm);  // Run always = 1 & 
-										// Enable = 1
-	// Select PD6 = ADC6
-	ADC0_MUXPOS = 0x12;  // Selects channe6, which is aux 12V voltage
-	 	 
-	// Set Vref == 4.096 volts, and is always on...
-	VREF_ADC0REF = VREF_ALWAYSON_bm | VREF_REFSEL1_bm ; 
-
-	// OPTIONAL NOISE REDUCING CODE...
-	// Set ACCUM == 4 (four samples returned)	// OPTIONAL NOISE REDUCING CODE...
-	// ADC0_CTRLB |= ADC_SAMPNUM_ACC8_gc;		// OPTIONAL NOISE REDUCING CODE...
-	
-	// Small delay .... ????
-	_delay_ms (1);
-	 
-	// START CONVERSION...
-	ADC0_COMMAND |= PIN0_bm;  // Start a conversion
-	                           // Bit-0 is CLRd when converion complete
-	// Wait for END-OF-CONVERSION (Bit-0 cleared)
-	while (ADC0_COMMAND & PIN0_bm) {};  // Bit-0 == 0 == EOC
-	 
-	//Conversion complete... Build result int, and return
-	adc_result_low = ADC0.RESL;   //get low byte, load high byte into TEMP
-	adc_result_int = (uint16_t) ((((ADC0.RESH) << 8) | adc_result_low));  
-													// correction if needed +30);
+	// Latest sample from the background scanner (ADC.h)
+	adc_result_int = adc_sample_get(ADC_CH_A5V);
 	multiplier = (uint16_t) 1467;
 	product = ((uint32_t)adc_result_int * (uint32_t)multiplier);
 	//current_batt_voltage = (product / ((uint16_t) 272));
@@ -1749,9 +1872,6 @@ void load_a5V_voltage (void)
 	current_batt_voltage = current_batt_voltage; // ~ 0.00 volts added!
 	// -----------------------------------------------------------------
 	
-	// Disable ADC... Enable = 0... Res = reset state
-	ADC0_CTRLA = 0;  // Enable is bit 1 == 1
-
 	//Convert to BCD digits for display 
 	current_batt_voltage = current_batt_voltage/10; // reduce mvs to tenths of mV
 	hundredths = current_batt_voltage%10;   // process & separate digits
@@ -1782,11 +1902,11 @@ void load_a5V_voltage (void)
 	//Entry Point for Main (Cold Reset)	
     // =====================================
 	
-	// SET SYSTEM CLOCK TO 8MHz !!!!
-	fcpu_init();
+	// SET SYSTEM CLOCK TO 8MHz !!!!
+	fcpu_init();
+	TCB0_tick_init();   // 1 mS tick (SOCH timeouts, scheduler)
 
 	uint32_t i = 0;   // ctr 4 determining when to STROBE 
-	uint32_t i_soch = 0;   // ctr 4 determining when to access SoCH 
 		
 	uint32_t flash_count = 0;   // counter for determining when to STROBE 
 								// the Alarm-LED When in STANDBY lower loop								
@@ -1818,9 +1938,8 @@ uint8_t PORTE_image = 0;      // PortE image at the occurrence of intr
 	PORTB.OUTCLR = PIN5_bm;  
 
 	// POWERUP DOUBLE BEEP-TONE... AT COLD START RESET
-	tone();
-    _delay_ms(175);
-	tone();
+	// (2nd beep from the scheduler, SCHED_TONE)
+	tone_beeps(2);
 
 	// CAREFULLY VERIFY....
 	//
@@ -1856,16 +1975,6 @@ uint8_t PORTE_image = 0;      // PortE image at the occurrence of intr
 	current_state = 0;     //  MOTOR_STATE;
 	receive_word = 0;     
 
-	//OLED BUSY & NAK FLAGS - Version 7 Addition for || processing 
-	oled1_busy_flag = 0;  // When a '1', must wait for executing
-	oled2_busy_flag = 0;  // command to end (which will reset
-	oled3_busy_flag = 0;  // the flag back to '0'...
-	
-	
-	oled1_NAK_flag = 0;   // When a '1', must wait for executing
-	oled2_NAK_flag = 0;   // command to end (which will reset
-	oled3_NAK_flag = 0;   // the flag back to '0'...
-
 	// Required STATE status flags...
 	standby_state_active_flag = 1;
 	evim_state_active_flag = 0;
@@ -2116,8 +2225,7 @@ while (1)
 	
 		// I M P O R T A N T  - - - - - - - - - - - - - - - 
 		// Returns system to "powerup" conditions...
-		VREF_ADC0REF = 0;
-		ADC0_CTRLA = 0; //reset all bits...	
+		adc_scan_stop();   // ADC0 and VREF back to reset state
 		USART0.BAUD = 0;
 		USART1.BAUD = 0;
 		USART2.BAUD = 0;
@@ -2128,6 +2236,9 @@ while (1)
 		USART1.CTRLB = 0;
 		USART2.CTRLB = 0;
 		USART3.CTRLB = 0;
+		sched_stop(SCHED_SOCH);   // Until USARTs_Init() again
+		sched_stop(SCHED_OLED_ALIVE);
+		oled_driver_init();       // Drop anything still queued for the OLEDs
 		
 	
 		// L O W E R  STANDBY   W A I T   L O O P (w\Strobing "Alarm Armed" LED) 
@@ -2175,6 +2286,7 @@ while (1)
 					flash_count = 0;
 				}
 			}  // If for DOOR and SEAT
+			sched_run();   // ESP32 requests, beeps
 			_delay_ms(1);
 
 	} // End of LOWER STANDBY Loop
@@ -2202,6 +2314,9 @@ while (1)
 		//   USART3 = OLED2 (Middle) */
 		USARTs_Init ();
 
+		// Temps and low voltages sampled in the background from here on
+		adc_scan_start();
+
 		// DISABLE UNNEEDED INTERRUPTS (assume nothing at this time!!!!)
 		// --------------------------------------------------------------
 		PORTB.PIN3CTRL &= ~PORT_ISC_BOTHEDGES_gc;  // RPG CH-B
@@ -2225,13 +2340,13 @@ while (1)
 
 		// Power DOWN (to be sure), then powerup the OLED modules...				
 		PORTA_OUTSET = PIN2_bm;	// set RESET to '1' == inactive
-		_delay_ms(1);   // Short delay
+		sched_delay_ms(1);   // Short delay
 		PORTA_OUTSET = PIN3_bm;	// PWRDEV to '1' = ALL Devices/OLEDs OFF.
 										
-		_delay_ms(60);  // Power down delay
+		sched_delay_ms(60);  // Power down delay
 		PORTA_OUTCLR = PIN3_bm;  // '0' == powerup OLED, RPG, plus...
 
-		_delay_ms(2);	
+		sched_delay_ms(2);	
 		oled_init();			 // Init ALL uOLED modules
 
 		PORTC_IN_image = PORTC.IN;  //PC7 == IGN, PC6=Accy, PC5=tail
@@ -2256,10 +2371,10 @@ while (1)
 
 			SOC_UART2_SndCmd(soc_reset);
 			tone();
-			_delay_ms(100);
+			sched_delay_ms(100);
 			SOC_UART2_SndCmd(soc_reset);
 			tone();
-			_delay_ms(100);
+			sched_delay_ms(100);
 			tone();
 			}
 
@@ -2291,76 +2406,33 @@ while (1)
 			// W A I T   f o r  I G N I T I O N   S i g n a l   L O O P
 			// W A I T   f o r  I G N I T I O N   S i g n a l   L O O P
 			// W A I T   f o r  I G N I T I O N   S i g n a l   L O O P
+			// Wait loop for Ignition signal, which is NOT coming along
+			// For WiFi Access !!  OLED activity refresh and the low
+			// voltage / temperature readings run as scheduled tasks
+			//-----------------------------------------------------------
+			sched_every(SCHED_OLED_ALIVE, SCHED_OLED_ALIVE_MS);
+			sched_every(SCHED_SENSORS, SCHED_SENSORS_MS);
+			sei();   // ESP32 RX, RPG button (rpg_on_flag), ADC scan
   			while ((PORTC.IN & PIN7_bm) == 0) {	
-				cli();
-				//Reset timeout for all OLEDs
-				oled1_setxt_position (4,6);   // activity refresh
-				oled2_setxt_position (4,6);   // (required)
-				oled3_setxt_position (4,6);   // 
-				sei();				
-
-
-
-
-				// Wait loop for Ignition signal, which is NOT coming along
-				// For WiFi Access !!
-				//-----------------------------------------------------------
-				//
-				// Get and store the low voltage digits in global variable:
-				load_a5V_voltage();
-				load_a12V_voltage();
-				load_133V_battery_voltage();
-			
-				// Load SoCH values (V, I, %SOC, kWh)	
-				cli();
-				verify_SOCH_online();
-		
-				// Get and store the low voltage digits in global variable:
-				// -------------------------------------
-				//Wait for SOCH to be ready...
-				_delay_ms(10);    // 20 worked...
-	
-				if (soch_offline_flag == 0)  {    // Then online, execute ...
-			        // Update SoCH values (Vpack, Ipack, SoC, kWh)
-			        SOC_UART2_SndCmd (&get_pack_voltage[0]);  //
-					Get_SOC_Response(&pack_voltage_array[0], 'V');
-					_delay_ms(5);
-
-					SOC_UART2_SndCmd (&get_pack_current[0]);  //
-					Get_SOC_Response(&pack_current_array[0], 'A');
-					_delay_ms(5);
-
-					SOC_UART2_SndCmd (&get_pack_soc[0]);  //
-					Get_SOC_Response(&pack_soc_array[0], '%');
-					_delay_ms(5);
-
-					SOC_UART2_SndCmd (&get_watthours_soc[0]);  //
-					Get_SOC_Response(&pack_kwh_array[0], 'W');
-					_delay_ms(5);
-				}
-						 
-
-				// Get and store the current temperature "raw" values
-				// (Must be processed/scaled to get digit values) 
-		        // ****************************************************
-			    get_temps();    // Load all current temps into array				
-				
-				scale_temps_array();
-				
-
-
+				// Keep SoCH values (V, I, %SOC, kWh) fresh for the ESP32
+				// (the engine refreshes each one on its own period)
+				soch_schedule_config(0, 0);
 
+				sched_run();   // ESP32 requests, OLEDs, sensors, SOCH
 
 				// TEST for in Charge MODE...
 				if ((PORTA.IN & PIN4_bm) != 0) { //OK, Charge Sig active
 				    _PROTECTED_WRITE(RSTCTRL.SWRR, PIN0_bm);
 				}
-			
+
 				//MUST Test for rpg_on_flag === 1...
 				if (rpg_on_flag == 1) {
 					break;	 
 				}
 			}  // END Of While (PORTC.IN & PIN7_bm)
+			cli();   // Rest of WAKE1 as before
+			sched_stop(SCHED_OLED_ALIVE);
+			sched_stop(SCHED_SENSORS);
 		 
 		 
 		 
@@ -2370,52 +2442,20 @@ while (1)
 			//-------------------------------------------------
 			contrast_level = 15;   // Max value
 			oled_contrast_set_cc(contrast_level);
-			_delay_ms(150);
-
-			cli();
-			// clear WAIT...
-			oled2_send_command (&oled_setxt_width_wide4[0]);
-			oled2_setxt_position (18,12);  //position for BIG WAIT.
-			oled2_putstring (&ClrWait[0]);			
-			sei();
 
-			tone();
-			_delay_ms(350); ///////   WAS 300 03132022
-			
-			cli();
-			reload_big_wait_mid_oled ();
-			oled1_setxt_position (3,14);
-			oled3_setxt_position (3,14);
-			sei();
-
-			// WAIT FOR FRONT CONTACTOR TO CLOSE...								
-			while (((PORTE.IN & PIN0_bm)==0) && (top_state_num==EVIM_STATE)) {	
-				//run each time through
-				_delay_ms(150);
-
-				cli();
-				// clear WAIT...
-				oled2_send_command (&oled_setxt_width_wide4[0]);
-				oled2_setxt_position (18,12);  //position for BIG WAIT.
-				oled2_putstring (&ClrWait[0]);			
-
-				sei();
-				tone();
-				_delay_ms(400);  // REQUIRED!   was 300 03102022
-			
-				cli();
-				reload_big_wait_mid_oled ();
-				oled1_setxt_position (3,14);
-				oled3_setxt_position (3,14);
-				sei();
-
-					////////////////////////////////////////////////////////////
-					// ADD WITH FSM VERSION
-					////////////////////////////////////////////////////////////
-					// FUTURE ENHANCEMENT... ADD TIME OUT *IF* FRONT CONTACTOR
-					//                       DOES NOT CLOSE ....................
-					////////////////////////////////////////////////////////////
-			}
+			// Flash the WAIT once, then WAIT FOR FRONT CONTACTOR TO
+			// CLOSE... while it keeps flashing (wait_flash_task)
+			wait_flash_count = 0;
+			wait_flash_cleared = 0;
+			sched_after(SCHED_WAIT_FLASH, WAIT_SHOWN_MS);
+			sched_wait(SCHED_WAIT_FLASH);
+
+				////////////////////////////////////////////////////////////
+				// ADD WITH FSM VERSION
+				////////////////////////////////////////////////////////////
+				// FUTURE ENHANCEMENT... ADD TIME OUT *IF* FRONT CONTACTOR
+				//                       DOES NOT CLOSE ....................
+				////////////////////////////////////////////////////////////
 		} // End of IF (rpg_on_flag != 1) && (warm_restart_flag == 0)
 
 
@@ -2626,7 +2666,7 @@ while (1)
 	contrast_level = 15;  	// BUT NOT SENT TO OLEDs YET...
 					// BUT NOT SENT TO OLEDs YET...
 					
-	_delay_ms(10); //////////////////////////////////////////////////
+	sched_delay_ms(10); //////////////////////////////////////////////////
 
 	//Turn OFF servo power, PA6 = SVO-SSR = 0 IFF IGN = 0
 	//	PORTA.OUTCLR = PIN6_bm;
@@ -2642,32 +2682,11 @@ while (1)
 	/////////////////////////////////////////////////
 	/////////////////////////////////////////////////
 	
-	cli();
-	verify_SOCH_online();
-		
-	//Wait for SOCH to be ready...
-	_delay_ms(10);    // 20 worked...
-	
-	if (soch_offline_flag == 0)  {    // Then online, execute ...
-        // Update SoCH values (Vpack, Ipack, SoC, kWh)
-        SOC_UART2_SndCmd (&get_pack_voltage[0]);  //
-		Get_SOC_Response(&pack_voltage_array[0], 'V');
-		_delay_ms(5);
-
-		SOC_UART2_SndCmd (&get_pack_current[0]);  //
-		Get_SOC_Response(&pack_current_array[0], 'A');
-		_delay_ms(5);
-
-		SOC_UART2_SndCmd (&get_pack_soc[0]);  //
-		Get_SOC_Response(&pack_soc_array[0], '%');
-		_delay_ms(5);
-
-		SOC_UART2_SndCmd (&get_watthours_soc[0]);  //
-		Get_SOC_Response(&pack_kwh_array[0], 'W');
-		_delay_ms(5);
-	}
-		
-	sei();
+	// Verify, then update SoCH values (Vpack, Ipack, SoC, kWh)
+	// Bounded by the engine timeouts (interrupts ON for the tick)
+	soch_poll_pack(SOCH_Q_ALL);
+	soch_engine_wait();
+	sched_every(SCHED_OLED_ALIVE, SCHED_OLED_ALIVE_MS);   // Screen may not change for a while
 					
 
   // L O W E R   I N F I N I T E   E V I M _ S T A T E = = = = = = = = = = = = 
@@ -2676,6 +2695,8 @@ while (1)
   while (top_state_num == EVIM_STATE)  
 	{
 
+	sched_run();   // ESP32 requests, SOCH, beeps
+
 	if (charge_cycle_active_flag == 1) {
 		mode_switch_counter++;  // increment mode switching counter
 		if (mode_switch_counter == 14) {
@@ -2685,72 +2706,17 @@ while (1)
 		}
 	}
 
-	cli();
-	verify_SOCH_online();
-		
-	//Wait for SOCH to be ready...
-	_delay_ms(10);    // 10 == Min Value
-
-	if (charge_cycle_active_flag == 1) {
-		if ((soch_offline_flag == 0) && (i_soch >= 4))  {  // Then online, Go... 
-		  if (dsp_mode_flag == 0) { // V-I mode
-			// Update SoCH values (Vpack, Ipack, SoC, kWh)
-	        SOC_UART2_SndCmd (&get_pack_voltage[0]);  //
-			Get_SOC_Response(&pack_voltage_array[0], 'V');
-			_delay_ms(5);
-
-			SOC_UART2_SndCmd (&get_pack_current[0]);  //
-			Get_SOC_Response(&pack_current_array[0], 'A');
-			_delay_ms(5);
-			i_soch = 0; 
-		  }
-		else  {    // %SoC and kWh mode
-			SOC_UART2_SndCmd (&get_pack_soc[0]);  //
-			Get_SOC_Response(&pack_soc_array[0], '%');
-			_delay_ms(5);
-
-			SOC_UART2_SndCmd (&get_watthours_soc[0]);  //
-			Get_SOC_Response(&pack_kwh_array[0], 'W');
-			_delay_ms(5);
-			i_soch = 0; 
-		}
-	  }
+	// Keep all four SoCH values fresh, whichever screen is up.  The
+	// engine (SOCH_InterfaceRoutines.inc) refreshes V-I fast and SoC-kWh
+	// slowly, everything slower while charging, and the pair on OLED2
+	// at least every SOCH_PERIOD_SHOWN_MS.  Runs while this pass updates
+	// the OLEDs.
+	if (dsp_mode_flag == 0) { // V-I mode
+		soch_schedule_config(charge_cycle_active_flag, SOCH_Q_VOLTAGE | SOCH_Q_CURRENT);
 	}
-	else if (soch_offline_flag == 0)  {  // Then online, Go... 
-	  if (dsp_mode_flag == 0) { // V-I mode
-        // Update SoCH values (Vpack, Ipack, SoC, kWh)
-        SOC_UART2_SndCmd (&get_pack_voltage[0]);  //
-		Get_SOC_Response(&pack_voltage_array[0], 'V');
-		_delay_ms(5);
-
-		SOC_UART2_SndCmd (&get_pack_current[0]);  //
-		Get_SOC_Response(&pack_current_array[0], 'A');
-		_delay_ms(5);
-		i_soch = 0; 
-	  }
-
-	  else  {    // %SoC and kWh mode
-		SOC_UART2_SndCmd (&get_pack_soc[0]);  //
-		Get_SOC_Response(&pack_soc_array[0], '%');
-		_delay_ms(5);
-
-		SOC_UART2_SndCmd (&get_watthours_soc[0]);  //
-		Get_SOC_Response(&pack_kwh_array[0], 'W');
-		_delay_ms(5);
-		i_soch = 0; 
-	  }
+	else {    // %SoC and kWh mode
+		soch_schedule_config(charge_cycle_active_flag, SOCH_Q_SOC | SOCH_Q_KWH);
 	}
-  
-
-	// ************************************************************	
-	// Charge Mode Slow Down Counter
-	// The counter must reach compare value to run soch requests 
-	// for data update
-	// 	
-	i_soch++; // increment counter for running soch request. 
-	// ************************************************************	
-
-	sei();
 						
 	/// SET OLED TEXT/NUMERIC CHARACTER COLOR
 	// Get current state of Tailite Signal
@@ -2975,40 +2941,15 @@ void get_133V_battery_voltage (void)
   {
 	uint16_t adc_result_int, multiplier, current_batt_voltage;
 	uint32_t product;   // 4 byte product
-	uint8_t adc_result_low; //unsigned byte variables.
             
 	uint16_t hundredths; 
 	uint16_t tenths;
 	uint16_t units;
     uint16_t tens;
+	uint8_t text[5];    // digits, sent as one string
  
-	// Set ADC Enable bit to 1...
-	ADC0_CTRLA = 0; //reset all bits...
-	ADC0_CTRLA |= (PIN7_bm | PIN0_bm);  // Run always = 1 & 
-										// Enable = 1
-	// Select PD7 = ADC7
-	ADC0_MUXPOS = 0x07;  // Selects channel6, which is accy batt voltage
-	 	 
-	// Set Vref == 4.096 volts, and is always on...
-	VREF_ADC0REF = VREF_ALWAYSON_bm | VREF_REFSEL1_bm ; 
-
-	// OPTIONAL NOISE REDUCING CODE...
-	  // Set ACCUM == 4 (four samples returned)	// OPTIONAL NOISE REDUCING CODE...
-	  // ADC0_CTRLB |= ADC_SAMPNUM_ACC8_gc;		// OPTIONAL NOISE REDUCING CODE...
-	
-	// Small delay .... ????
-	_delay_ms (1);
-	 
-	// START CONVERSION...
-	ADC0_COMMAND |= PIN0_bm;  // Start a conversion
-	                           // Bit-0 is CLRd when converion complete
-							 
-	// Wait for END-OF-CONVERSION (Bit-0 cleared)
-	while (ADC0_COMMAND & PIN0_bm) {};  // Bit-0 == 0 == EOC
-	 
-	//Conversion complete... Build result int, and return
-	adc_result_low = ADC0.RESL;   //get low byte, load high byte into TEMP
-	adc_result_int = (uint16_t) ((((ADC0.RESH) << 8) | adc_result_low) +30);
+	// Latest sample from the background scanner (ADC.h)
+	adc_result_int = adc_sample_get(ADC_CH_ACCY133) + 30;
 
 	multiplier = (uint16_t) 1000;
 	product = ((uint32_t)adc_result_int * (uint32_t)multiplier);
@@ -3021,13 +2962,6 @@ void get_133V_battery_voltage (void)
 	current_batt_voltage = current_batt_voltage - 110;  // Due to in car shift?!	
 	// -------------------------------------------
 	
-	// Disable ADC... Enable = 0... Res = reset state
-	ADC0_CTRLA = 0;  // Enable is bit 1 == 1
-
-	// OPTIONAL NOISE REDUCING CODE...
-    //// current_batt_voltage = current_batt_voltage >> 3; // for ACCUM feature
-
-	
 	// Convert to BCD digits for display 
 	// (process & separate digits)
 	current_batt_voltage = current_batt_voltage/10; // reduce mv to TENTHS of mV
@@ -3052,14 +2986,15 @@ void get_133V_battery_voltage (void)
     oled1_setxt_position (33,78);
  		   
     if (tens != 0)
-       putcharOLED1 (0x30 + tens);
+       text[0] = 0x30 + tens;
 	else
-	   putcharOLED1 (' ');
+	   text[0] = ' ';
 		
-	   putcharOLED1 (0x30 + units);
-	   putcharOLED1 ('.');
-	   putcharOLED1 (0x30 + tenths);
-	   putcharOLED1 (0x30 + hundredths);
+	text[1] = 0x30 + units;
+	text[2] = '.';
+	text[3] = 0x30 + tenths;
+	text[4] = 0x30 + hundredths;
+	oled_putchars(OLED1, text, 5);
 }
 		
 
@@ -3077,39 +3012,15 @@ void get_a12V_voltage (void)
   {
 	uint16_t adc_result_int, multiplier, current_batt_voltage;
 	uint32_t product;   // 4 byte product
-	uint8_t adc_result_low; //unsigned byte variables.
             
 	uint16_t hundredths; 
 	uint16_t tenths;
 	uint16_t units;
     uint16_t tens;
+	uint8_t text[4];    // digits, sent as one string
  
-	// Set ADC Enable bit to 1...
-	ADC0_CTRLA = 0; //reset all bits...
-	ADC0_CTRLA |= (PIN6_bm | PIN0_bm);  // Run always = 1 & 
-										// Enable = 1
-	// Select PD6 = ADC6
-	ADC0_MUXPOS = 0x06;  // Selects channe6, which is aux 12V voltage
-	 	 
-	// Set Vref == 4.096 volts, and is always on...
-	VREF_ADC0REF = VREF_ALWAYSON_bm | VREF_REFSEL1_bm ; 
-
-	// OPTIONAL NOISE REDUCING CODE...
-	// Set ACCUM == 4 (four samples returned)	// OPTIONAL NOISE REDUCING CODE...
-	// ADC0_CTRLB |= ADC_SAMPNUM_ACC8_gc;		// OPTIONAL NOISE REDUCING CODE...
-	
-	// Small delay .... ????
-	_delay_ms (1);
-	 
-	// START CONVERSION...
-	ADC0_COMMAND |= PIN0_bm;  // Start a conversion
-	                           // Bit-0 is CLRd when converion complete
-	// Wait for END-OF-CONVERSION (Bit-0 cleared)
-	while (ADC0_COMMAND & PIN0_bm) {};  // Bit-0 == 0 == EOC
-	 
-	//Conversion complete... Build result int, and return
-	adc_result_low = ADC0.RESL;   //get low byte, load high byte into TEMP
-	adc_result_int = (uint16_t) ((((ADC0.RESH) << 8) | adc_result_low) +30);
+	// Latest sample from the background scanner (ADC.h)
+	adc_result_int = adc_sample_get(ADC_CH_A12V) + 30;
 
 	multiplier = (uint16_t) 1000;
 	product = ((uint32_t)adc_result_int * (uint32_t)multiplier);
@@ -3120,12 +3031,6 @@ void get_a12V_voltage (void)
 	current_batt_voltage = current_batt_voltage + 200; // ~ 0.200 volts added
 	//////// OFFSET/Correction Adjustment...  
 	//////// OFFSET/Correction Adjustment...
-
-	// Disable ADC... Enable = 0... Res = reset state
-	ADC0_CTRLA = 0;  // Enable is bit 1 == 1
-
-	// OPTIONAL NOISE REDUCING CODE...
-    //// current_batt_voltage = current_batt_voltage >> 3;  // for ACCUM reduction
 	
 	//Convert to BCD digits for display 
 	current_batt_voltage = current_batt_voltage/10; // reduce mvs to 1/10s of mV
@@ -3157,15 +3062,16 @@ void get_a12V_voltage (void)
  		
 	// tens digit, and leading 0!	  	   
     if (tens == 0) {
-		putcharOLED2 (' ');
+		text[0] = ' ';
 		}	
 	else {
-		putcharOLED2 (0x30 + tens);
+		text[0] = 0x30 + tens;
 		}
 
-	putcharOLED2 (0x30 + units);
-	putcharOLED2 ('.');
-	putcharOLED2 (0x30 + tenths);
+	text[1] = 0x30 + units;
+	text[2] = '.';
+	text[3] = 0x30 + tenths;
+	oled_putchars(OLED2, text, 4);
 	}
 
 
@@ -3199,39 +3105,14 @@ void get_a5V_voltage (void)
   {
 	uint16_t adc_result_int, multiplier, current_batt_voltage;
 	uint32_t product;   // 4 byte product
-	uint8_t adc_result_low; //unsigned byte variables.
             
 	uint16_t hundredths; 
 	uint16_t tenths;
 	uint16_t units;
+	uint8_t text[4];    // digits, sent as one string
  
-	// Set ADC Enable bit to 1...
-	ADC0_CTRLA = 0; //reset all bits...
-	ADC0_CTRLA |= (PIN6_bm | PIN0_bm);  // Run always = 1 & 
-										// Enable = 1
-	// Select PD6 = ADC6
-	ADC0_MUXPOS = 0x12;  // Selects channe6, which is aux 12V voltage
-	 	 
-	// Set Vref == 4.096 volts, and is always on...
-	VREF_ADC0REF = VREF_ALWAYSON_bm | VREF_REFSEL1_bm ; 
-
-	// OPTIONAL NOISE REDUCING CODE...
-	// Set ACCUM == 4 (four samples returned)	// OPTIONAL NOISE REDUCING CODE...
-	// ADC0_CTRLB |= ADC_SAMPNUM_ACC8_gc;		// OPTIONAL NOISE REDUCING CODE...
-	
-	// Small delay .... ????
-	_delay_ms (1);
-	 
-	// START CONVERSION...
-	ADC0_COMMAND |= PIN0_bm;  // Start a conversion
-	                           // Bit-0 is CLRd when converion complete
-	// Wait for END-OF-CONVERSION (Bit-0 cleared)
-	while (ADC0_COMMAND & PIN0_bm) {};  // Bit-0 == 0 == EOC
-	 
-	//Conversion complete... Build result int, and return
-	adc_result_low = ADC0.RESL;   //get low byte, load high byte into TEMP
-	adc_result_int = (uint16_t) ((((ADC0.RESH) << 8) | adc_result_low));  
-													// correction if needed +30);
+	// Latest sample from the background scanner (ADC.h)
+	adc_result_int = adc_sample_get(ADC_CH_A5V);
 	multiplier = (uint16_t) 1467;
 	product = ((uint32_t)adc_result_int * (uint32_t)multiplier);
 	//current_batt_voltage = (product / ((uint16_t) 272));
@@ -3243,9 +3124,6 @@ void get_a5V_voltage (void)
 	current_batt_voltage = current_batt_voltage; // ~ 0.00 volts added!
 	// -----------------------------------------------------------------
 	
-	// Disable ADC... Enable = 0... Res = reset state
-	ADC0_CTRLA = 0;  // Enable is bit 1 == 1
-
 	//Convert to BCD digits for display 
 	current_batt_voltage = current_batt_voltage/10; // reduce mvs to tenths of mV
 	hundredths = current_batt_voltage%10;   // process & separate digits
@@ -3264,10 +3142,11 @@ void get_a5V_voltage (void)
 	oled2_send_command (&oled_setxt_width_narrow[0]);
     oled2_setxt_position (25,102);   // was 30,104
 
-	putcharOLED2 (0x30 + units);
-	putcharOLED2 ('.');
-	putcharOLED2 (0x30 + tenths);
-	putcharOLED2 (0x30 + hundredths);
+	text[0] = 0x30 + units;
+	text[1] = '.';
+	text[2] = 0x30 + tenths;
+	text[3] = 0x30 + hundredths;
+	oled_putchars(OLED2, text, 4);
 
 	//Add the " V" for voltage...
 	oled2_setxt_position (57,102);
@@ -3299,16 +3178,11 @@ void get_a5V_voltage (void)
 // ****************************************************************
 void get_temps (void)
 {
-  int16_t adc_val;
   int16_t channel_num=0;
 
   while (channel_num < 6)
     {
-      adc_val = get_adc_ntc10k(channel_num);  // TWICE !!!!!
-      adc_val = get_adc_ntc10k(channel_num);  // Seems to be req'd
-                                         // INVESTIGATE THIS
-										 // TRY ADDING DELAY @ TOP of LOOP...............................
-      current_temps_array[channel_num]= adc_val;
+      current_temps_array[channel_num]= get_adc_ntc10k(channel_num);
       channel_num++;
     }
 }
@@ -3317,42 +3191,13 @@ void get_temps (void)
 // ****************************************************************
 //  int16_t get_adc_ntc10k (uint16_t channel_number)
 //
+//  Latest 2.5V reference sample of PD0..PD5 from the background
+//  scanner (ADC.h), no waiting.
 //  Temp = (ADC# * SLOPE)/100 - INTERCEPT
 // ****************************************************************
  int16_t get_adc_ntc10k (uint16_t channel_number)
   {
-    uint16_t adc_result_int;
-    uint8_t adc_result_low; //unsigned byte variables.
-
-	// Set ADC Config (On, 12Bit, Enabled
-	// Bit7 = NoSleep;  Bit2 = 10bit Res;  Bit0 = ADC Enable;
-	ADC0_CTRLA =0; // clear previous bits... 	
-	ADC0_CTRLA |= (PIN7_bm | PIN0_bm); 	
-	
-	ADC0_MUXPOS = (char) (0x00 | channel_number);
-	
-	// Set Vref == 2.5 volts, and is always on...
-	// (VREF_REFSEL_2V500_gc = (0x03<<0))
-	VREF_ADC0REF = VREF_ALWAYSON_bm | VREF_REFSEL_2V500_gc;  // 2.5V Selection
-
-	// OPTIONAL NOISE REDUCING CODE...
-	//// Set ACCUM == 4 (four samples returned)
-	//// ADC0_CTRLB |= ADC_SAMPNUM_ACC8_gc;
-	
-	// Small delay .... ????
-	_delay_ms (1);
-	
-	// START CONVERSION...
-	ADC0_COMMAND |= PIN0_bm;  // Start a conversion
-	// Bit-0 is CLRd when converion complete
-
-	// Wait for END-OF-CONVERSION (Bit-0 cleared)
-	while (ADC0_COMMAND & PIN0_bm) {};  // Bit-0 == 0 == EOC
-	
-	//Conversion complete... Build result int, and return
-	adc_result_low = ADC0.RESL;   //get low byte, load high byte into TEMP
-	adc_result_int = (uint16_t) ((((ADC0.RESH) << 8) | adc_result_low) +30);
-    return (adc_result_int);     
+    return (adc_sample_get(ADC_CH_MOTOR + channel_number) + 30);
    }
 
 
@@ -3518,20 +3363,16 @@ void load_evim_screen_lines (void)
 // --------------------------------------------------------
 void load_tmparray_display (void)
 {
-	uint16_t adc_current_val;
 	 int16_t current_scaled_temp;  // CNT NEEDED???
-	 int16_t *ptr;  // To TempsArray
 			   
-		// get temps... load array   
+		// get temps... load array (scanner samples, no waiting)
         // ****************************************************
 	       get_temps();    // Load all current temps into array
 		   scale_temps_array();
    
-       //    display current state temp   
+       //    display current state temp (already scaled above)
    	   //******************************************************
-		ptr = &current_temps_array [state_num];
-	    adc_current_val = *ptr;   // get current temp for state_num 
-	    current_scaled_temp = scale_temp_ntc10k (adc_current_val);
+	    current_scaled_temp = scaled_temps_array [state_num];
 
 	    //display current scaled temperature
 		oled3_send_command (&oled_setxt_height[0]);
@@ -3561,6 +3402,7 @@ void dsp_ps_temp ( int16_t temp2disp)
       int16_t tens;
       int16_t hundreds;
       int16_t temp_celcius;
+      uint8_t text[5];    // digits, sent as one string
 
 	///// cli();
       int16_t tmp = temp2disp;
@@ -3647,11 +3489,12 @@ void dsp_ps_temp ( int16_t temp2disp)
 			oled3_send_command (&oled_setxt_height[0]);
  			oled3_send_command (&oled_setxt_width[0]);
 			oled3_setxt_position (32,78);      
-			putcharOLED3 (0x30 + hundreds); 
-	        putcharOLED3 (0x30 + tens);
-		    putcharOLED3 (0x30 + units);
-			putcharOLED3 ('.');
-	        putcharOLED3 (0x30 + tenths);
+			text[0] = 0x30 + hundreds; 
+	        text[1] = 0x30 + tens;
+		    text[2] = 0x30 + units;
+			text[3] = '.';
+	        text[4] = 0x30 + tenths;
+			oled_putchars(OLED3, text, 5);
         
 		    //Do "Degrees"  & "F" notation....
 			oled3_setxt_position (106,70);   //was 103,70
@@ -3671,10 +3514,11 @@ void dsp_ps_temp ( int16_t temp2disp)
 
 		    //------------------
 	        oled3_setxt_position (36,78);
-		    putcharOLED3 (0x30 + tens);
-			putcharOLED3 (0x30 + units);
-	        putcharOLED3 ('.');
-		    putcharOLED3 (0x30 + tenths);
+		    text[0] = 0x30 + tens;
+			text[1] = 0x30 + units;
+	        text[2] = '.';
+		    text[3] = 0x30 + tenths;
+			oled_putchars(OLED3, text, 4);
         	
 		    //Do "Degrees"  & "F" notation....
 			oled3_send_command (&oled_setxt_width[0]);
@@ -3694,13 +3538,14 @@ void dsp_ps_temp ( int16_t temp2disp)
 			oled3_send_command (&oled_setxt_height[0]);
 			oled3_send_command (&oled_setxt_width[0]);
 	        oled3_setxt_position (32,78);
-		    putcharOLED3 (' ');  // For cleanup...
-			putcharOLED3 (0x30 + units);
-	        putcharOLED3 ('.');
-		    putcharOLED3 (0x30 + tenths);
+		    text[0] = ' ';  // For cleanup...
+			text[1] = 0x30 + units;
+	        text[2] = '.';
+		    text[3] = 0x30 + tenths;
 			
             // ADDED SPACE 06102020
-	        putcharOLED3 (' ');
+	        text[4] = ' ';
+			oled_putchars(OLED3, text, 5);
 
 			//Do "Degrees F" notation....
 	        oled3_setxt_position (98,70);   //was  98,70